@@ -0,0 +1,98 @@
+/**
+ * @brief Define la interfaz del almacén de memoria por partida
+ *
+ * @file arena.h
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include "types.h"
+
+/**
+ * @brief Estructura opaca del almacén: reserva bloques grandes y los reparte
+ * sin liberar nada hasta que se destruye entero.
+ */
+typedef struct _Arena Arena;
+
+/**
+ * @brief Crea un almacén vacío.
+ * @author Unai
+ * @param block_size Tamaño en bytes de cada bloque que se pide al sistema.
+ * @return Puntero al almacén creado o NULL en caso de error.
+ */
+Arena *arena_create(size_t block_size);
+
+/**
+ * @brief Libera de una vez toda la memoria repartida por el almacén.
+ * @author Unai
+ * @param arena Puntero al almacén.
+ * @return OK si se destruye con éxito, ERROR en caso contrario.
+ */
+Status arena_destroy(Arena *arena);
+
+/**
+ * @brief Reserva memoria inicializada a cero.
+ *
+ * Si arena es NULL la memoria se reserva en el heap con calloc.
+ * @author Unai
+ * @param arena Puntero al almacén o NULL.
+ * @param size Número de bytes.
+ * @return Puntero a la memoria reservada o NULL en caso de error.
+ */
+void *arena_alloc(Arena *arena, size_t size);
+
+/**
+ * @brief Amplía una reserva conservando su contenido.
+ *
+ * Si arena es NULL equivale a realloc. En otro caso, si ptr es la última
+ * reserva del bloque actual y hay sitio, crece en el mismo lugar; si no,
+ * se copia a un hueco nuevo y el anterior queda en el almacén hasta su
+ * destrucción. Pedir un tamaño menor devuelve ptr sin cambios.
+ * @author Unai
+ * @param arena Puntero al almacén o NULL.
+ * @param ptr Reserva previa (puede ser NULL).
+ * @param old_size Tamaño en bytes de la reserva previa.
+ * @param new_size Tamaño en bytes pedido.
+ * @return Puntero a la nueva reserva o NULL en caso de error (ptr sigue siendo válido).
+ */
+void *arena_realloc(Arena *arena, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Devuelve una reserva.
+ *
+ * Si arena es NULL equivale a free; en otro caso no hace nada, porque la
+ * memoria se libera al destruir el almacén.
+ * @author Unai
+ * @param arena Puntero al almacén o NULL.
+ * @param ptr Reserva a devolver.
+ */
+void arena_free(Arena *arena, void *ptr);
+
+/**
+ * @brief Sustituye una cadena por una copia de text.
+ *
+ * La copia se reserva con el tamaño exacto de text y solo entonces se
+ * devuelve la cadena anterior; si la reserva falla *field no cambia.
+ * @author Unai
+ * @param arena Puntero al almacén o NULL.
+ * @param field Cadena que se sustituye (*field puede ser NULL).
+ * @param text Texto a copiar.
+ * @return OK si tiene éxito, ERROR en caso contrario.
+ */
+Status arena_set_string(Arena *arena, char **field, const char *text);
+
+/**
+ * @brief Obtiene el número de bytes repartidos por el almacén.
+ * @author Unai
+ * @param arena Puntero al almacén.
+ * @return Bytes repartidos o 0 si hay error.
+ */
+size_t arena_get_used(Arena *arena);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef ARENA_TEST_H
+#define ARENA_TEST_H
+
+void test1_arena_create();
+void test2_arena_create();
+void test1_arena_destroy();
+void test2_arena_destroy();
+void test1_arena_alloc();
+void test2_arena_alloc();
+void test3_arena_alloc();
+void test4_arena_alloc();
+void test1_arena_realloc();
+void test2_arena_realloc();
+void test3_arena_realloc();
+void test1_arena_get_used();
+void test2_arena_get_used();
+void test1_arena_set_string();
+void test2_arena_set_string();
+void test3_arena_set_string();
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @brief Define la interfaz del conjunto de posiciones en mapa de bits
+ *
+ * @file bitset.h
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef BITSET_H
+#define BITSET_H
+
+#include "types.h"
+#include "arena.h"
+
+/**
+ * @brief Estructura opaca del mapa de bits: el bit i indica si la posición i
+ * pertenece al conjunto. Crece al añadir posiciones mayores que su capacidad.
+ */
+typedef struct _Bitset Bitset;
+
+/**
+ * @brief Crea un mapa de bits vacío con sitio para al menos n_bits posiciones.
+ * @author Unai
+ * @param n_bits Número de posiciones esperadas (el mapa crece si se supera).
+ * @return Puntero al mapa creado o NULL en caso de error.
+ */
+Bitset *bitset_create(int n_bits);
+
+/**
+ * @brief Crea un mapa de bits vacío reservado en un almacén.
+ *
+ * Sus palabras crecen dentro del mismo almacén y se liberan con él.
+ * @author Unai
+ * @param arena Almacén del que se reserva (NULL para usar el heap).
+ * @param n_bits Número de posiciones esperadas (el mapa crece si se supera).
+ * @return Puntero al mapa creado o NULL en caso de error.
+ */
+Bitset *bitset_create_in(Arena *arena, int n_bits);
+
+/**
+ * @brief Libera la memoria del mapa de bits.
+ * @author Unai
+ * @param bitset Puntero al mapa.
+ * @return OK si se destruye con éxito, ERROR en caso contrario.
+ */
+Status bitset_destroy(Bitset *bitset);
+
+/**
+ * @brief Añade una posición al conjunto.
+ * @author Unai
+ * @param bitset Puntero al mapa.
+ * @param index Posición a añadir (no negativa).
+ * @return OK si se añade con éxito, ERROR en caso contrario.
+ */
+Status bitset_add(Bitset *bitset, int index);
+
+/**
+ * @brief Quita una posición del conjunto.
+ * @author Unai
+ * @param bitset Puntero al mapa.
+ * @param index Posición a quitar.
+ * @return OK si se quita con éxito, ERROR si no estaba o hay error.
+ */
+Status bitset_del(Bitset *bitset, int index);
+
+/**
+ * @brief Comprueba si una posición pertenece al conjunto.
+ * @author Unai
+ * @param bitset Puntero al mapa.
+ * @param index Posición a comprobar.
+ * @return TRUE si pertenece, FALSE si no pertenece o hay error.
+ */
+BOOL bitset_contains(Bitset *bitset, int index);
+
+/**
+ * @brief Cuenta las posiciones del conjunto.
+ * @author Unai
+ * @param bitset Puntero al mapa.
+ * @return Número de posiciones o -1 si hay error.
+ */
+int bitset_count(Bitset *bitset);
+
+/**
+ * @brief Deja en dst solo las posiciones que también están en src.
+ * @author Unai
+ * @param dst Puntero al mapa que se modifica.
+ * @param src Puntero al mapa con el que se intersecta.
+ * @return OK si se intersecta con éxito, ERROR en caso contrario.
+ */
+Status bitset_and(Bitset *dst, Bitset *src);
+
+/**
+ * @brief Comprueba si dos conjuntos comparten alguna posición.
+ * @author Unai
+ * @param a Puntero al primer mapa.
+ * @param b Puntero al segundo mapa.
+ * @return TRUE si comparten alguna posición, FALSE si no o hay error.
+ */
+BOOL bitset_intersects(Bitset *a, Bitset *b);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef BITSET_TEST_H
+#define BITSET_TEST_H
+
+void test1_bitset_create();
+void test2_bitset_create();
+void test3_bitset_create();
+void test1_bitset_destroy();
+void test2_bitset_destroy();
+void test1_bitset_add();
+void test2_bitset_add();
+void test3_bitset_add();
+void test1_bitset_del();
+void test2_bitset_del();
+void test1_bitset_contains();
+void test2_bitset_contains();
+void test1_bitset_count();
+void test1_bitset_and();
+void test1_bitset_intersects();
+void test2_bitset_intersects();
+
+#endif
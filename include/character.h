@@ -12,7 +12,7 @@
 #define CHARACTER_H
 
 #include "types.h"
-#define MAX_CHARACTERS 100
+#include "arena.h"
 #define CHARACTER_NAME_LEN 30
 
 typedef struct _Character Character;
@@ -26,6 +26,16 @@ typedef struct _Character Character;
   */
 Character *character_create(Id id);
 
+/**
+  * @brief Crea un nuevo personaje cuya memoria sale de un almacén
+  * @author Unai
+  *
+  * @param arena Almacén del que se reserva (NULL para usar el heap)
+  * @param id El id del personaje a crear
+  * @return Un puntero al personaje creado,NULL si hay error
+  */
+Character *character_create_in(Arena *arena, Id id);
+
 /**
   * @brief Destruye un personaje
   * @author Rodrigo
@@ -43,6 +53,15 @@ void character_destroy(Character *character);
   */
 Id character_get_id(Character *character);
 
+/**
+  * @brief Obtiene el almacén del que salió la memoria de un personaje
+  * @author Unai
+  *
+  * @param character Un puntero a personaje
+  * @return El almacén o NULL si el personaje está en el heap o hay error
+  */
+Arena *character_get_arena(Character *character);
+
 /**
   * @brief Obtiene el nombre de un personaje
   * @author Rodrigo
@@ -11,10 +11,11 @@
 #ifndef COMMAND_H
 #define COMMAND_H
 
+#include <stdio.h>
 #include "types.h"
 
 #define N_CMDT 2
-#define N_CMD 13
+#define N_CMD 15
 
 /**
  * @brief Tipos de formato para los comandos (corto o largo)
@@ -24,7 +25,7 @@ typedef enum { CMDS, CMDL } CommandType;
 /**
  * @brief Códigos de los comandos disponibles en el juego
  */
-typedef enum { NO_CMD = -1, UNKNOWN, EXIT, TAKE, DROP , ATTACK , CHAT, MOVE, INSPECT, RECRUIT, ABANDON, USE, OPEN} CommandCode;
+typedef enum { NO_CMD = -1, UNKNOWN, EXIT, TAKE, DROP , ATTACK , CHAT, MOVE, INSPECT, RECRUIT, ABANDON, USE, OPEN, SAVE, LOAD} CommandCode;
 
 /**
  * @brief Estructura opaca del comando
@@ -86,6 +87,43 @@ char* command_get_last_input(Command* command);
  */
 Status command_get_user_input(Command* command);
 
+/**
+ * @brief Lee el siguiente comando de un flujo de entrada (archivo o stdin).
+ *
+ * Al llegar al final del flujo se asigna el comando de salida.
+ * @author Unai
+ * @param command Puntero al comando donde se guardará la entrada.
+ * @param input Flujo del que se lee una línea.
+ * @return OK si se lee con éxito, ERROR en caso contrario.
+ */
+Status command_get_input_from(Command* command, FILE* input);
+
+/**
+ * @brief Interpreta una línea ya leída (por ejemplo, recibida por un socket).
+ * @author Unai
+ * @param command Puntero al comando donde se guardará la entrada.
+ * @param line Línea de texto con el comando y sus argumentos.
+ * @return OK si se interpreta con éxito, ERROR en caso contrario.
+ */
+Status command_parse_input(Command* command, char* line);
+
+/**
+ * @brief Obtiene el nombre de un código de comando.
+ * @author Unai
+ * @param code Código del comando.
+ * @param type CMDS para la forma corta o CMDL para la larga.
+ * @return El nombre del comando o una cadena vacía si el código no es válido.
+ */
+const char* command_code_to_str(CommandCode code, CommandType type);
+
+/**
+ * @brief Traduce el nombre de una dirección (north/n, south/s, ...).
+ * @author Unai
+ * @param str Nombre de la dirección, sin distinguir mayúsculas.
+ * @return La dirección o NO_DIRECTION si no se reconoce.
+ */
+Directions command_str_to_direction(const char* str);
+
 /**
  * @brief Obtiene el número de argumentos del comando.
  * @author Unai.G
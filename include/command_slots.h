@@ -0,0 +1,18 @@
+/* Generado por command_slots a partir de command_words.h (make slots): no editar */
+
+#ifndef COMMAND_SLOTS_H
+#define COMMAND_SLOTS_H
+
+#define VERB_SLOTS 64
+static const signed char verb_slots[VERB_SLOTS] = {
+  10, -1, -1, -1,  9, 15, -1, -1, -1, -1, 23, -1, -1, 19, 13,  6,
+  -1, 27,  5,  7,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, 20, -1,
+  -1, -1, -1, -1, 22, 18, 24, 28, 16, -1, 12, -1, -1, -1, -1, -1,
+  29, -1, -1, -1, 25, 11, -1, -1, -1, 21, 26, 17, 14, -1, -1,  8};
+
+#define DIRECTION_SLOTS 32
+static const signed char direction_slots[DIRECTION_SLOTS] = {
+  -1, -1, -1, -1,  8, -1, -1, -1, -1, -1, -1,  1, -1, -1,  6, -1,
+   9,  0,  5, -1,  4,  3,  7, -1, -1, -1,  2, -1, -1, -1, 11, 10};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef COMMAND_TEST_H
+#define COMMAND_TEST_H
+
+void test1_command_parse_input();
+void test2_command_parse_input();
+void test3_command_parse_input();
+void test4_command_parse_input();
+void test5_command_parse_input();
+void test1_command_str_to_direction();
+void test2_command_str_to_direction();
+void test3_command_str_to_direction();
+void test4_command_str_to_direction();
+
+#endif
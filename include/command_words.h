@@ -0,0 +1,43 @@
+/**
+ * @brief Define las palabras que reconoce el intérprete de comandos
+ *
+ * @file command_words.h
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef COMMAND_WORDS_H
+#define COMMAND_WORDS_H
+
+#include "command.h"
+
+/*
+ * Lista unica de verbos y direcciones, con su nombre corto (CMDS) y largo
+ * (CMDL). La leen command.c y el generador command_slots, que calcula con
+ * ella las tablas de huecos de command_slots.h. Son tablas de solo lectura:
+ * pueden compartirse entre hilos sin sincronizar.
+ */
+
+/**
+ * @brief Nombres de cada comando, por posicion code - NO_CMD.
+ */
+static const char *const cmd_to_str[N_CMD][N_CMDT] = {{"", "No command"}, {"", "Unknown"}, {"e", "exit"}, {"t", "Take"}, {"d", "drop"}, {"a", "attack"}, {"c", "chat"}, {"m", "move"}, {"i", "inspect"}, {"r", "recruit"}, {"ab", "abandon"}, {"u", "use"}, {"o", "open"}, {"s", "save"}, {"l", "load"}};
+
+/**
+ * @brief Nombres de cada direccion, por posicion en Directions.
+ */
+static const char *const dir_to_str[][N_CMDT] = {{"n", "north"}, {"s", "south"}, {"e", "east"}, {"w", "west"}, {"u", "up"}, {"d", "down"}};
+
+#define N_DIR_WORDS ((int)(sizeof(dir_to_str) / sizeof(dir_to_str[0])))
+
+/*
+ * Hueco de una palabra en una tabla de n huecos (n potencia de dos), a
+ * partir de su primera y ultima letra en minusculas y su longitud. El
+ * hueco guarda fila * N_CMDT + formato de la palabra en su tabla de
+ * nombres, o -1 si esta libre.
+ */
+#define COMMAND_WORD_SLOT(first, last, len, n) ((2 * (first) + 19 * (last) + 11 * (len)) & ((n) - 1))
+
+#endif
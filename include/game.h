@@ -18,9 +18,7 @@
 #include "object.h"
 #include "character.h"
 #include "types.h"
-
-/** @brief Número máximo de espacios en el juego */
-#define MAX_SPACES 100
+#include "arena.h"
 
 /**
  * @brief Estructura principal de Game (opaca)
@@ -56,6 +54,16 @@ Status game_create_from_file(Game **game, char *filename);
  */
 Status game_destroy(Game *game);
 
+/**
+ * @brief Obtiene el almacén de memoria de la partida.
+ *
+ * Las entidades creadas en él se liberan todas juntas en game_destroy.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @return Puntero al almacén o NULL si hay error.
+ */
+Arena *game_get_arena(Game *game);
+
 /**
  * @brief Añade un nuevo espacio al array del juego.
  * @author Unai
@@ -100,6 +108,15 @@ Status game_set_player_location(Game *game, Id id);
  */
 Id game_get_object_location(Game *game, Id object_id);
 
+/**
+ * @brief Obtiene la ubicación del objeto que ocupa una posición densa.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param position Posición del objeto (entre 0 y el número de objetos - 1).
+ * @return ID del espacio donde está el objeto, o NO_ID si no está en ninguno o hay error.
+ */
+Id game_get_object_location_at(Game *game, int position);
+
 /**
  * @brief Establece la ubicación física de un objeto en el mapa.
  * @author Unai
@@ -110,6 +127,62 @@ Id game_get_object_location(Game *game, Id object_id);
  */
 Status game_set_object_location(Game *game, Id space_id, Id object_id);
 
+/**
+ * @brief Establece la ubicación de un objeto a partir de posiciones densas.
+ *
+ * Igual que game_set_object_location pero sin traducir Ids, para quien ya
+ * conoce las posiciones (como el cargador de la imagen compilada).
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param object Posición del objeto (entre 0 y el número de objetos - 1).
+ * @param space Posición del espacio destino, o -1 para quitarlo del mapa.
+ * @return OK si tiene éxito, ERROR en caso contrario.
+ */
+Status game_set_object_location_at(Game *game, int object, int space);
+
+/**
+ * @brief Comprueba si un objeto está en un espacio con un único bit.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param space_id ID del espacio.
+ * @param object_id ID del objeto.
+ * @return TRUE si el objeto está en el espacio, FALSE si no está o hay error.
+ */
+BOOL game_space_has_object(Game *game, Id space_id, Id object_id);
+
+/**
+ * @brief Comprueba si el jugador activo lleva un objeto con un único bit.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param object_id ID del objeto.
+ * @return TRUE si el objeto está en la mochila, FALSE si no está o hay error.
+ */
+BOOL game_player_has_object(Game *game, Id object_id);
+
+/**
+ * @brief Guarda un objeto del juego en la mochila del jugador activo.
+ *
+ * Los jugadores ya añadidos al juego deben cambiar su mochila con esta
+ * función y no con player_add_object, para que el juego la vea.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param object_id ID del objeto.
+ * @return OK si tiene éxito, ERROR si la mochila está llena o hay error.
+ */
+Status game_player_add_object(Game *game, Id object_id);
+
+/**
+ * @brief Saca un objeto de la mochila del jugador activo.
+ *
+ * Los jugadores ya añadidos al juego deben cambiar su mochila con esta
+ * función y no con player_del_object, para que el juego la vea.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param object_id ID del objeto.
+ * @return OK si tiene éxito, ERROR si no lo llevaba o hay error.
+ */
+Status game_player_del_object(Game *game, Id object_id);
+
 /**
  * @brief Obtiene la ubicación actual de un personaje concreto.
  * @author Unai
@@ -119,6 +192,15 @@ Status game_set_object_location(Game *game, Id space_id, Id object_id);
  */
 Id game_get_character_location(Game *game, Id character_id);
 
+/**
+ * @brief Obtiene la ubicación del personaje que ocupa una posición densa.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param position Posición del personaje (entre 0 y el número de personajes - 1).
+ * @return ID del espacio donde está el personaje, o NO_ID si no está en ninguno o hay error.
+ */
+Id game_get_character_location_at(Game *game, int position);
+
 /**
  * @brief Establece la ubicación física de un personaje en el mapa.
  * @author Unai
@@ -129,6 +211,51 @@ Id game_get_character_location(Game *game, Id character_id);
  */
 Status game_set_character_location(Game *game, Id space_id, Id character_id);
 
+/**
+ * @brief Establece la ubicación de un personaje a partir de posiciones densas.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param character Posición del personaje (entre 0 y el número de personajes - 1).
+ * @param space Posición del espacio destino, o -1 para quitarlo del mapa.
+ * @return OK si tiene éxito, ERROR en caso contrario.
+ */
+Status game_set_character_location_at(Game *game, int character, int space);
+
+/**
+ * @brief Obtiene la salud del personaje que ocupa una posición densa.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param position Posición del personaje (entre 0 y el número de personajes - 1).
+ * @return Puntos de salud del personaje, o 0 si hay error.
+ */
+int game_get_character_health_at(Game *game, int position);
+
+/**
+ * @brief Cambia la salud de un personaje del juego.
+ *
+ * Los personajes ya añadidos al juego deben cambiar su salud con esta
+ * función y no con character_set_health, para que el juego la vea.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param character_id ID del personaje.
+ * @param health Nuevos puntos de salud.
+ * @return OK si tiene éxito, ERROR en caso contrario.
+ */
+Status game_set_character_health(Game *game, Id character_id, int health);
+
+/**
+ * @brief Cambia a quién sigue un personaje del juego.
+ *
+ * Los personajes ya añadidos al juego deben cambiar su seguimiento con esta
+ * función y no con character_set_following, para que el juego lo vea.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param character_id ID del personaje.
+ * @param following ID del jugador al que sigue, o NO_ID para que deje de seguir.
+ * @return OK si tiene éxito, ERROR en caso contrario.
+ */
+Status game_set_character_following(Game *game, Id character_id, Id following);
+
 /**
  * @brief Obtiene el último comando ejecutado.
  * @author Unai
@@ -231,6 +358,42 @@ Character* game_get_character(Game* game, Id id);
  */
 Character *game_get_character_at(Game *game, int position);
 
+/**
+ * @brief Traduce el identificador de un espacio a su posición densa.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param id ID del espacio.
+ * @return Posición entre 0 y el número de espacios - 1, o -1 si no existe.
+ */
+int game_get_space_index(Game *game, Id id);
+
+/**
+ * @brief Traduce el identificador de un objeto a su posición densa.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param id ID del objeto.
+ * @return Posición entre 0 y el número de objetos - 1, o -1 si no existe.
+ */
+int game_get_object_index(Game *game, Id id);
+
+/**
+ * @brief Traduce el identificador de un personaje a su posición densa.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param id ID del personaje.
+ * @return Posición entre 0 y el número de personajes - 1, o -1 si no existe.
+ */
+int game_get_character_index(Game *game, Id id);
+
+/**
+ * @brief Traduce el identificador de un enlace a su posición densa.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param id ID del enlace.
+ * @return Posición entre 0 y el número de enlaces - 1, o -1 si no existe.
+ */
+int game_get_link_index(Game *game, Id id);
+
 /**
  * @brief Añade un nuevo objeto a la lista general del juego.
  * @author Unai
@@ -311,6 +474,16 @@ int game_get_number_of_links(Game *game);
  */
 Status game_add_link(Game *game, Link *link);
 
+/**
+ * @brief Añade un enlace colgándolo del espacio que ocupa una posición densa.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param link Puntero al enlace a añadir.
+ * @param origin Posición del espacio de origen, o -1 si aún no está cargado.
+ * @return OK si se añade con éxito, ERROR si no hay espacio o hay fallo.
+ */
+Status game_add_link_at(Game *game, Link *link, int origin);
+
 /**
  * @brief Obtiene el turno actual del juego.
  * @author Unai
@@ -326,6 +499,26 @@ int game_get_turn(Game *game);
  */
 void game_next_turn(Game *game);
 
+/**
+ * @brief Reinicia el generador aleatorio de la partida.
+ *
+ * Con la misma semilla y los mismos comandos la partida se repite igual.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param seed Semilla del generador.
+ * @return OK si se asigna con éxito, ERROR en caso contrario.
+ */
+Status game_set_seed(Game *game, unsigned long seed);
+
+/**
+ * @brief Obtiene el siguiente número del generador aleatorio de la partida.
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param max Cota superior (excluida), mayor que 0.
+ * @return Un número entre 0 y max - 1, o -1 si hay error.
+ */
+int game_get_random(Game *game, int max);
+
 /**
  * @brief Establece la descripción de un objeto para su inspección.
  * @author Alejandro Dominguez
@@ -427,6 +620,14 @@ int game_get_number_of_space(Game *game);
  * @return el espacio del indice o NULL en caso de error
  */
 Space*game_get_space_from_index(Game*game,int n);
+/**
+ * @brief Obtiene el enlace por indice
+ * @author Unai
+ * @param game Puntero al juego.
+ * @param n indice
+ * @return el enlace del indice o NULL en caso de error
+ */
+Link *game_get_link_from_index(Game*game, int n);
 /**
  * @brief Obtiene un personaje concreto del juego a partir de su ID.
  * @author Unai.G
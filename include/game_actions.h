@@ -23,4 +23,14 @@
  */
 Status game_actions_update(Game *game, Command *cmd);
 
+/**
+ * @brief Tira el dado de turno tras una acción de exploración válida.
+ *
+ * Si la tirada es baja pasa el turno al siguiente jugador y deja el
+ * resultado en el mensaje de chat de la partida.
+ * @param game Puntero al juego principal.
+ * @param cmd Puntero al último comando ejecutado.
+ */
+void game_actions_update_turn(Game *game, Command *cmd);
+
 #endif
\ No newline at end of file
@@ -45,6 +45,28 @@ Status game_managment_load_objects(Game *game, char *filename);
  * @return OK si se lee correctamente, ERROR si hay algún fallo.
  */
 Status game_managment_load_spaces(Game *game, char *filename);
+/**
+ * @brief Carga todas las entidades del juego leyendo el archivo una sola vez.
+ * @author Unai
+ * @param game Puntero al juego principal donde se añadirán las entidades.
+ * @param filename Cadena de caracteres con el nombre del archivo.
+ * @return OK si se lee correctamente, ERROR si hay algún fallo.
+ */
+Status game_managment_load_game(Game *game, char *filename);
+/**
+ * @brief Guarda el mundo cargado como imagen binaria compilada.
+ *
+ * La imagen contiene registros de anchura fija, una tabla de cadenas y las
+ * referencias a espacios ya resueltas; game_managment_load_game la reconoce
+ * por su firma y la carga sin analizar texto. Un mundo con enlaces que la
+ * imagen no puede guardar (dirección repetida en un espacio, origen o
+ * destino inexistente) se rechaza y cada enlace se nombra por stderr.
+ * @author Unai
+ * @param game Puntero al juego con el mundo recien cargado.
+ * @param filename Cadena de caracteres con el nombre del archivo de salida.
+ * @return OK si se escribe correctamente, ERROR si hay algún fallo.
+ */
+Status game_managment_compile_world(Game *game, char *filename);
 Status game_managment_save_game(Game *game, char *filename);
 
 
@@ -0,0 +1,11 @@
+#ifndef GAME_SERVER_TEST_H
+#define GAME_SERVER_TEST_H
+
+void test1_game_server_save();
+void test2_game_server_save();
+void test1_game_server_load();
+void test1_game_server_exit();
+void test1_game_server_read();
+void test2_game_server_exit();
+
+#endif
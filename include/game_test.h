@@ -0,0 +1,15 @@
+#ifndef GAME_TEST_H
+#define GAME_TEST_H
+
+void test1_game_create_from_file();
+void test2_game_create_from_file();
+void test3_game_create_from_file();
+void test1_game_player_add_object();
+void test1_game_player_del_object();
+void test1_game_player_has_object();
+void test1_game_set_object_location();
+void test1_game_add_space();
+void test1_game_managment_compile_world();
+void test2_game_managment_compile_world();
+
+#endif
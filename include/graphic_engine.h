@@ -25,6 +25,16 @@ typedef struct _Graphic_engine Graphic_engine;
  */
 Graphic_engine* graphic_engine_create();
 
+/**
+ * @brief Crea un motor gráfico que compone los fotogramas en memoria
+ *
+ * Usa la misma disposición que el motor del terminal pero no escribe nada
+ * en él; cada instancia es independiente de las demás.
+ * @author Unai
+ * @return Puntero al nuevo motor gráfico o NULL en caso de error
+ */
+Graphic_engine* graphic_engine_create_buffer();
+
 /**
  * @brief Destruye el motor gráfico y libera la memoria de las áreas de pantalla
  * @author Unai
@@ -32,6 +42,16 @@ Graphic_engine* graphic_engine_create();
  */
 void graphic_engine_destroy(Graphic_engine* ge);
 
+/**
+ * @brief Olvida las salas guardadas de la partida pintada hasta ahora
+ *
+ * Hay que llamarla antes de pintar con el mismo motor una partida distinta
+ * de la anterior.
+ * @author Unai
+ * @param ge Puntero al motor gráfico
+ */
+void graphic_engine_reset(Graphic_engine* ge);
+
 /**
  * @brief Dibuja el estado actual del juego en las diferentes áreas de la interfaz
  * @author Unai
@@ -41,4 +61,24 @@ void graphic_engine_destroy(Graphic_engine* ge);
  */
 void graphic_engine_paint_game(Graphic_engine* ge, Game* game, Status last_cmd_status, BOOL paint_cmd);
 
+/**
+ * @brief Copia como texto el último fotograma de un motor en memoria
+ *
+ * Cada fila acaba en '\n' y tras ellas va la línea del prompt o de fin de
+ * partida que el motor del terminal imprimiría.
+ * @author Unai
+ * @param ge Puntero al motor gráfico creado con graphic_engine_create_buffer
+ * @param buf Buffer que recibe el texto
+ * @param size Tamaño de buf (basta con graphic_engine_get_frame_size)
+ * @return Longitud del texto o -1 si hay error o no cabe
+ */
+int graphic_engine_render(Graphic_engine* ge, char* buf, int size);
+
+/**
+ * @brief Obtiene el tamaño de buffer que necesita graphic_engine_render
+ * @author Unai
+ * @return Número de bytes suficiente para cualquier fotograma
+ */
+int graphic_engine_get_frame_size();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+ * @brief Define la interfaz del índice hash de identificadores
+ *
+ * @file id_map.h
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef ID_MAP_H
+#define ID_MAP_H
+
+#include "types.h"
+
+/** @brief Valor devuelto cuando un Id no está en el índice */
+#define ID_MAP_NOT_FOUND -1
+
+/**
+ * @brief Estructura opaca del índice Id -> posición.
+ */
+typedef struct _IdMap IdMap;
+
+/**
+ * @brief Crea un índice vacío con capacidad para al menos n_elems claves.
+ * @author Unai
+ * @param n_elems Número de claves esperadas (el índice crece si se supera).
+ * @return Puntero al índice creado o NULL en caso de error.
+ */
+IdMap *id_map_create(int n_elems);
+
+/**
+ * @brief Libera la memoria del índice.
+ * @author Unai
+ * @param map Puntero al índice.
+ * @return OK si se destruye con éxito, ERROR en caso contrario.
+ */
+Status id_map_destroy(IdMap *map);
+
+/**
+ * @brief Asocia una posición a un identificador (sobrescribe si ya existe).
+ * @author Unai
+ * @param map Puntero al índice.
+ * @param id Identificador clave.
+ * @param position Posición asociada (no negativa).
+ * @return OK si se inserta con éxito, ERROR en caso contrario.
+ */
+Status id_map_put(IdMap *map, Id id, int position);
+
+/**
+ * @brief Elimina un identificador del índice.
+ * @author Unai
+ * @param map Puntero al índice.
+ * @param id Identificador a eliminar.
+ * @return OK si se elimina con éxito, ERROR si no existe o hay error.
+ */
+Status id_map_del(IdMap *map, Id id);
+
+/**
+ * @brief Obtiene la posición asociada a un identificador.
+ * @author Unai
+ * @param map Puntero al índice.
+ * @param id Identificador a buscar.
+ * @return La posición asociada o ID_MAP_NOT_FOUND si no existe.
+ */
+int id_map_get(IdMap *map, Id id);
+
+/**
+ * @brief Obtiene el número de claves almacenadas.
+ * @author Unai
+ * @param map Puntero al índice.
+ * @return Número de claves o -1 si hay error.
+ */
+int id_map_get_n_elems(IdMap *map);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef ID_MAP_TEST_H
+#define ID_MAP_TEST_H
+
+void test1_id_map_create();
+void test2_id_map_create();
+void test1_id_map_destroy();
+void test2_id_map_destroy();
+void test1_id_map_put();
+void test2_id_map_put();
+void test1_id_map_get();
+void test2_id_map_get();
+void test3_id_map_get();
+void test1_id_map_del();
+void test2_id_map_del();
+void test1_id_map_get_n_elems();
+void test2_id_map_get_n_elems();
+
+#endif
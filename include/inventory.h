@@ -29,6 +29,16 @@ typedef struct _Inventory Inventory;
  */
 Inventory *inventory_create(int max_objs);
 
+/**
+ * @brief Crea un inventario cuya memoria sale de un almacén.
+ * @author Unai
+ *
+ * @param arena Almacén del que se reserva (NULL para usar el heap).
+ * @param max_objs Máximo de objetos.
+ * @return Puntero al nuevo inventario. NULL si hay error.
+ */
+Inventory *inventory_create_in(Arena *arena, int max_objs);
+
 /**
  * @brief Destruye un inventario.
  * @author Rodrigo
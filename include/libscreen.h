@@ -12,6 +12,7 @@
 #define LIBSCREEN_H
 
 typedef struct _Area Area;
+typedef struct _ScreenBuffer ScreenBuffer;
 typedef enum {BLUE, GREEN, BLACK, RED, YELLOW, PURPLE, CYAN, WHITE} Frame_color;
 
 
@@ -41,7 +42,8 @@ void screen_destroy();
  * @author Profesores PPROG
  *
  * This function should be called when some updates
- *  in the screen want to be shown.
+ *  in the screen want to be shown. Only the cells that changed since
+ *  the previous call are sent to the terminal, in a single write.
  */
 void screen_paint(Frame_color color);
 
@@ -99,4 +101,51 @@ void screen_area_reset_cursor(Area* area);
  */
 void screen_area_puts(Area* area, char* str);
 
+/**
+ * @brief It creates a screen that lives only in memory
+ * @author Unai
+ *
+ * Areas created on it with screen_buffer_area_init behave exactly as the
+ *  ones on the terminal screen, but nothing is ever written to the terminal.
+ *  Several of them can be used at once, each one from its own thread.
+ * @param rows the number of rows of the screen
+ * @param columns the number of columns of the screen
+ * @return a new screen, or NULL on error
+ */
+ScreenBuffer* screen_buffer_create(int rows, int columns);
+
+/**
+ * @brief It destroys a screen created with screen_buffer_create
+ * @author Unai
+ *
+ * Its areas must have been destroyed before.
+ * @param screen the screen to be freed
+ */
+void screen_buffer_destroy(ScreenBuffer* screen);
+
+/**
+ * @brief It creates a new area inside a memory screen
+ * @author Unai
+ * @param screen the screen that will hold the area
+ * @param x the x-coordinate of the up-left corner of the area
+ * @param y the y-coordinate of the up-left corner of the area
+ * @param width the width of the area
+ * @param height the height of the area
+ * @return a new area, or NULL if it does not fit in the screen
+ */
+Area* screen_buffer_area_init(ScreenBuffer* screen, int x, int y, int width, int height);
+
+/**
+ * @brief It copies the screen composition into a text buffer
+ * @author Unai
+ *
+ * Every row is written followed by a '\n' and the text ends with a '\0',
+ *  so the buffer needs rows * (columns + 1) + 1 bytes.
+ * @param screen the screen to be rendered
+ * @param buf the buffer that receives the text
+ * @param size the size of buf
+ * @return the length of the text, or -1 if it does not fit
+ */
+int screen_buffer_render(ScreenBuffer* screen, char* buf, int size);
+
 #endif
@@ -0,0 +1,18 @@
+#ifndef LIBSCREEN_TEST_H
+#define LIBSCREEN_TEST_H
+
+void test1_screen_buffer_create();
+void test2_screen_buffer_create();
+void test1_screen_buffer_area_init();
+void test2_screen_buffer_area_init();
+void test1_screen_buffer_render();
+void test2_screen_buffer_render();
+void test3_screen_buffer_render();
+void test1_screen_area_puts();
+void test2_screen_area_puts();
+void test3_screen_area_puts();
+void test4_screen_area_puts();
+void test5_screen_area_puts();
+void test1_screen_area_clear();
+
+#endif
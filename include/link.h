@@ -12,6 +12,7 @@
 #define LINK_H
 
 #include "types.h"
+#include "arena.h"
 
 /**
  * @brief Estructura opaca que representa un enlace entre espacios
@@ -26,6 +27,15 @@ typedef struct _Link Link;
  */
 Link* link_create(Id id);
 
+/**
+ * @brief Crea un nuevo enlace cuya memoria sale de un almacén
+ * @author Unai
+ * @param arena Almacén del que se reserva (NULL para usar el heap)
+ * @param id Identificador único del enlace
+ * @return Puntero al enlace creado o NULL si hay error
+ */
+Link* link_create_in(Arena* arena, Id id);
+
 /**
  * @brief Destruye un enlace y libera su memoria
  * @author Unai.G
@@ -87,6 +97,14 @@ Status link_set_open(Link* link, BOOL open);
  */
 Id link_get_id(Link* link);
 
+/**
+ * @brief Obtiene el almacén del que salió la memoria de un enlace
+ * @author Unai
+ * @param link Puntero al enlace
+ * @return El almacén o NULL si el enlace está en el heap o hay error
+ */
+Arena* link_get_arena(Link* link);
+
 /**
  * @brief Obtiene el nombre de un enlace
  * @author Unai.G
@@ -11,6 +11,7 @@
 #define OBJECT_H
 
 #include "types.h"
+#include "arena.h"
 
 /* Definición de la estructura de datos opaca */
 typedef struct Object Object;
@@ -22,6 +23,14 @@ typedef struct Object Object;
  */
 Object* object_create(Id id);
 
+/**
+ * @brief Crea un nuevo objeto cuya memoria sale de un almacén
+ * @param arena Almacén del que se reserva (NULL para usar el heap)
+ * @param id Identificador del objeto
+ * @return Puntero al nuevo objeto o NULL si hay error
+ */
+Object* object_create_in(Arena* arena, Id id);
+
 /**
  * @brief Destruye un objeto y libera memoria
  * @param object Puntero al objeto
@@ -36,6 +45,13 @@ Status object_destroy(Object* object);
  */
 Id object_get_id(Object* object);
 
+/**
+ * @brief Obtiene el almacén del que salió la memoria de un objeto
+ * @param object Puntero al objeto
+ * @return El almacén o NULL si el objeto está en el heap o hay error
+ */
+Arena* object_get_arena(Object* object);
+
 /**
  * @brief Establece el nombre de un objeto
  * @param object Puntero al objeto
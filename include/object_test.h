@@ -5,6 +5,7 @@ void test1_object_create(void);
 void test2_object_create(void);
 void test1_object_set_name(void);
 void test2_object_set_name(void);
+void test3_object_set_name(void);
 void test1_object_set_desc(void);
 void test2_object_set_desc(void);
 void test1_object_get_id(void);
@@ -15,6 +16,7 @@ void test1_object_print(void);
 void test2_object_print(void);
 void test1_object_get_desc(void);
 void test2_object_get_desc(void);
+void test3_object_get_desc(void);
 void test1_object_destroy(void);
 void test2_object_destroy(void);
 
@@ -28,6 +28,16 @@ typedef struct Player Player;
  */
 Player* player_create(Id id);
 
+/**
+ * @brief Crea un nuevo jugador cuya memoria sale de un almacén
+ * @author Unai
+ *
+ * @param arena almacén del que se reserva (NULL para usar el heap)
+ * @param id el número de identificación para el nuevo jugador
+ * @return un nuevo jugador inicializado, o NULL en caso de error
+ */
+Player* player_create_in(Arena* arena, Id id);
+
 /**
  * @brief Destruye un jugador, liberando la memoria previamente reservada
  * @author Unai
@@ -46,6 +56,15 @@ Status player_destroy(Player* player);
  */
 Id player_get_id(Player* player);
 
+/**
+ * @brief Obtiene el almacén del que salió la memoria de un jugador
+ * @author Unai
+ *
+ * @param player puntero al jugador
+ * @return el almacén o NULL si el jugador está en el heap o hay error
+ */
+Arena* player_get_arena(Player* player);
+
 /**
  * @brief Establece el nombre de un jugador
  * @author Unai
@@ -12,6 +12,7 @@
 #define SET_H
 
 #include "types.h"
+#include "arena.h"
 
 /**
  * @brief Estructura opaca para manejar un conjunto (set).
@@ -24,6 +25,13 @@ typedef struct Set Set;
  */
 Set* set_create();
 
+/**
+ * @brief Crea un nuevo conjunto cuya memoria sale de un almacén.
+ * @param arena Almacén del que se reserva (NULL para usar el heap).
+ * @return Puntero al nuevo conjunto o NULL en caso de error.
+ */
+Set* set_create_in(Arena* arena);
+
 /**
  * @brief Libera la memoria reservada para un conjunto.
  * @param s Puntero al conjunto a eliminar.
@@ -41,6 +49,9 @@ Status set_add(Set* s, Id id);
 
 /**
  * @brief Elimina un elemento específico del conjunto.
+ *
+ * Los demás elementos conservan su orden de inserción, así que el borrado
+ * cuesta O(n) aunque el conjunto tenga tabla hash.
  * @param s Puntero al conjunto.
  * @param id Identificador que se desea eliminar.
  * @return OK si tiene éxito, ERROR en caso contrario.
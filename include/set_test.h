@@ -4,6 +4,7 @@ void test1_set_create();
 void test2_set_create();
 void test1_set_add();
 void test2_set_add();
+void test3_set_add();
 void test1_set_del();
 void test2_set_del();
 void test1_set_find();
@@ -16,4 +17,7 @@ void test1_set_get_ids();
 void test2_set_get_ids();
 void test1_set_destroy();
 void test2_set_destroy();
+void test4_set_add();
+void test3_set_del();
+void test3_set_find();
 #endif
\ No newline at end of file
@@ -17,6 +17,7 @@
 
 #define GDESC_ROWS 5
 #define GDESC_COLS 14
+#define N_DIRECTIONS 6
 
 typedef struct Space Space;
 
@@ -27,6 +28,14 @@ typedef struct Space Space;
  */
 Space* space_create(Id id);
 
+/**
+ * @brief Crea un nuevo espacio cuya memoria sale de un almacén
+ * @param arena Almacén del que se reserva (NULL para usar el heap)
+ * @param id Identificador único del espacio
+ * @return Puntero al nuevo espacio o NULL en caso de error
+ */
+Space* space_create_in(Arena* arena, Id id);
+
 /**
  * @brief Destruye un espacio y libera su memoria
  * @param space Puntero al espacio a destruir
@@ -41,6 +50,13 @@ Status space_destroy(Space* space);
  */
 Id space_get_id(Space* space);
 
+/**
+ * @brief Obtiene el almacén del que salió la memoria de un espacio
+ * @param space Puntero al espacio
+ * @return El almacén o NULL si el espacio está en el heap o hay error
+ */
+Arena* space_get_arena(Space* space);
+
 /**
  * @brief Establece el nombre de un espacio
  * @param space Puntero al espacio
@@ -58,13 +74,21 @@ const char* space_get_name(Space* space);
 
 
 /**
- * @brief Añade un nuevo enlace al espacio buscando el primer hueco disponible
+ * @brief Añade un enlace saliente al espacio en el hueco de su dirección
  * @param space Puntero al espacio
- * @param link Puntero al enlace que se desea añadir
- * @return OK si se añade con éxito, ERROR si no hay espacio o los parámetros son nulos
+ * @param link Puntero al enlace que se desea añadir (el espacio no pasa a ser su dueño)
+ * @return OK si se añade con éxito, ERROR si la dirección ya está ocupada o los parámetros son nulos
  */
 Status space_add_link(Space* space, Link* link);
 
+/**
+ * @brief Obtiene el enlace saliente del espacio en una dirección
+ * @param space Puntero al espacio
+ * @param dir Dirección del enlace
+ * @return Puntero al enlace o NULL si no hay enlace en esa dirección
+ */
+Link* space_get_link_at(Space* space, Directions dir);
+
 /**
  * @brief Busca y devuelve un enlace del espacio a partir de su ID
  * @param space Puntero al espacio
@@ -152,6 +176,14 @@ Status space_set_gdesc(Space* space, char gdesc[GDESC_ROWS][GDESC_COLS]);
  */
 char(* space_get_gdesc(Space* space))[GDESC_COLS];
 
+/**
+ * @brief Obtiene una fila de la descripción gráfica del espacio
+ * @param s Puntero al espacio
+ * @param n Fila a obtener (entre 0 y GDESC_ROWS - 1)
+ * @return Puntero a la fila o NULL si hay error
+ */
+char *space_get_gdes_from_index(Space*s, int n);
+
 /**
  * @brief Imprime la información del espacio por pantalla
  * @param space Puntero al espacio
@@ -187,4 +219,14 @@ BOOL space_get_discovered(Space* space);
  */
 int space_get_n_characters(Space* space);
 
+/**
+ * @brief Obtiene la revisión del espacio
+ *
+ * Cambia cada vez que se modifica algo de lo que se pinta del espacio
+ * (nombre, enlaces, objetos, personajes, dibujo o si está descubierto).
+ * @param space Puntero al espacio
+ * @return Revisión actual o -1 en caso de error
+ */
+long space_get_revision(Space* space);
+
 #endif
@@ -34,5 +34,12 @@ void test1_space_get_gdesc();
 void test2_space_get_gdesc();
 void test1_space_set_gdesc();
 void test2_space_set_gdesc();
+void test1_space_add_link();
+void test2_space_add_link();
+void test1_space_get_link_at();
+void test2_space_get_link_at();
+void test1_space_get_revision();
+void test2_space_get_revision();
+void test3_space_get_revision();
 
 #endif
\ No newline at end of file
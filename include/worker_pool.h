@@ -0,0 +1,87 @@
+/**
+ * @brief Define la interfaz del conjunto de hilos que ejecuta sesiones
+ *
+ * @file worker_pool.h
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "types.h"
+
+/**
+ * @brief Estructura opaca del conjunto de hilos: cada hilo tiene su propia
+ * cola de sesiones listas y, cuando se vacía, roba de las de los demás.
+ */
+typedef struct _WorkerPool WorkerPool;
+
+/**
+ * @brief Estructura opaca de una sesión: serializa sus tareas, que se
+ * ejecutan de una en una y en el orden en que se enviaron.
+ */
+typedef struct _WorkerStrand WorkerStrand;
+
+/**
+ * @brief Función que ejecuta una tarea; recibe el argumento enviado.
+ */
+typedef void (*WorkerTaskFn)(void *arg);
+
+/**
+ * @brief Crea el conjunto y arranca sus hilos.
+ * @author Unai
+ * @param n_workers Número de hilos (mayor que cero).
+ * @return Puntero al conjunto creado o NULL en caso de error.
+ */
+WorkerPool *worker_pool_create(int n_workers);
+
+/**
+ * @brief Espera a que terminen todas las tareas enviadas, detiene los hilos
+ * y libera el conjunto. Las sesiones deben haberse destruido antes.
+ * @author Unai
+ * @param pool Puntero al conjunto.
+ * @return OK si se destruye con éxito, ERROR en caso contrario.
+ */
+Status worker_pool_destroy(WorkerPool *pool);
+
+/**
+ * @brief Crea una sesión vacía asociada al conjunto.
+ * @author Unai
+ * @param pool Puntero al conjunto.
+ * @return Puntero a la sesión creada o NULL en caso de error.
+ */
+WorkerStrand *worker_pool_strand_create(WorkerPool *pool);
+
+/**
+ * @brief Espera a que la sesión termine sus tareas y la libera.
+ * @author Unai
+ * @param strand Puntero a la sesión.
+ * @return OK si se destruye con éxito, ERROR en caso contrario.
+ */
+Status worker_pool_strand_destroy(WorkerStrand *strand);
+
+/**
+ * @brief Encola una tarea en una sesión.
+ *
+ * Las tareas de una misma sesión nunca se ejecutan a la vez y respetan el
+ * orden de envío; las de sesiones distintas se reparten entre los hilos.
+ * @author Unai
+ * @param strand Puntero a la sesión.
+ * @param run Función que ejecuta la tarea.
+ * @param arg Argumento que se pasa a run.
+ * @return OK si se encola con éxito, ERROR en caso contrario.
+ */
+Status worker_pool_submit(WorkerStrand *strand, WorkerTaskFn run, void *arg);
+
+/**
+ * @brief Obtiene el número de hilos del conjunto.
+ * @author Unai
+ * @param pool Puntero al conjunto.
+ * @return Número de hilos o -1 si hay error.
+ */
+int worker_pool_get_n_workers(WorkerPool *pool);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef WORKER_POOL_TEST_H
+#define WORKER_POOL_TEST_H
+
+void test1_worker_pool_create();
+void test2_worker_pool_create();
+void test1_worker_pool_destroy();
+void test2_worker_pool_destroy();
+void test1_worker_pool_strand_create();
+void test2_worker_pool_strand_create();
+void test1_worker_pool_strand_destroy();
+void test2_worker_pool_strand_destroy();
+void test1_worker_pool_submit();
+void test2_worker_pool_submit();
+void test3_worker_pool_submit();
+void test1_worker_pool_get_n_workers();
+void test2_worker_pool_get_n_workers();
+
+#endif
@@ -0,0 +1,250 @@
+/**
+ * @brief Implementa el almacén de memoria por partida
+ *
+ * @file arena.c
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Tipo con la alineacion mas exigente de los datos del juego.
+ */
+typedef union
+{
+  long l;   /*!< Enteros e Ids */
+  double d; /*!< Reales */
+  void *p;  /*!< Punteros */
+} ArenaAlign;
+
+#define ALIGN_SIZE sizeof(ArenaAlign)
+#define ALIGN_UP(n) (((n) + ALIGN_SIZE - 1) / ALIGN_SIZE * ALIGN_SIZE)
+
+/**
+ * @brief ArenaBlock
+ * Bloque reservado al sistema; los datos empiezan tras la cabecera.
+ */
+typedef struct _ArenaBlock
+{
+  struct _ArenaBlock *next; /*!< Bloque anterior de la lista */
+  size_t size;              /*!< Bytes de datos del bloque */
+  size_t used;              /*!< Bytes de datos ya repartidos */
+  ArenaAlign align;         /*!< Alinea el final de la cabecera, donde empiezan los datos */
+} ArenaBlock;
+
+/**
+ * @brief Arena
+ * Lista de bloques; solo se reparte del primero. Las reservas mayores que
+ * un bloque van en uno propio detras de el, para no abandonar su hueco.
+ */
+struct _Arena
+{
+  ArenaBlock *blocks; /*!< Lista de bloques, el actual primero */
+  size_t block_size;  /*!< Tamaño de datos de cada bloque nuevo */
+  size_t used;        /*!< Bytes repartidos en total */
+};
+
+ArenaBlock *arena_new_block(Arena *arena, size_t size);
+void *arena_alloc_dedicated(Arena *arena, size_t size);
+
+ArenaBlock *arena_new_block(Arena *arena, size_t size)
+{
+  ArenaBlock *block = NULL;
+
+  /* calloc deja los datos a cero: nunca se reutiliza memoria del bloque */
+  block = (ArenaBlock *)calloc(1, sizeof(ArenaBlock) + size);
+  if (block == NULL)
+  {
+    return NULL;
+  }
+
+  block->size = size;
+  block->used = 0;
+  block->next = arena->blocks;
+  arena->blocks = block;
+  return block;
+}
+
+void *arena_alloc_dedicated(Arena *arena, size_t size)
+{
+  ArenaBlock *block = NULL;
+
+  block = (ArenaBlock *)calloc(1, sizeof(ArenaBlock) + size);
+  if (block == NULL)
+  {
+    return NULL;
+  }
+
+  /* Se engancha tras el bloque actual, que sigue repartiendo su hueco */
+  block->size = size;
+  block->used = size;
+  if (arena->blocks == NULL)
+  {
+    block->next = NULL;
+    arena->blocks = block;
+  }
+  else
+  {
+    block->next = arena->blocks->next;
+    arena->blocks->next = block;
+  }
+  arena->used += size;
+  return block + 1;
+}
+
+Arena *arena_create(size_t block_size)
+{
+  Arena *arena = NULL;
+
+  if (block_size == 0)
+  {
+    return NULL;
+  }
+
+  arena = (Arena *)calloc(1, sizeof(Arena));
+  /* Comprueba si falla la reserva de memoria */
+  if (arena == NULL)
+  {
+    return NULL;
+  }
+
+  arena->blocks = NULL;
+  arena->block_size = ALIGN_UP(block_size);
+  arena->used = 0;
+  return arena;
+}
+
+Status arena_destroy(Arena *arena)
+{
+  ArenaBlock *block = NULL;
+
+  if (!arena)
+  {
+    return ERROR;
+  }
+
+  /* Una liberacion por bloque, independiente del numero de reservas */
+  while (arena->blocks != NULL)
+  {
+    block = arena->blocks;
+    arena->blocks = block->next;
+    free(block);
+  }
+
+  free(arena);
+  return OK;
+}
+
+void *arena_alloc(Arena *arena, size_t size)
+{
+  ArenaBlock *block = NULL;
+  char *data = NULL;
+
+  if (arena == NULL)
+  {
+    return calloc(1, size);
+  }
+  if (size == 0)
+  {
+    return NULL;
+  }
+
+  size = ALIGN_UP(size);
+  block = arena->blocks;
+
+  /* Las reservas mayores que un bloque reciben uno propio */
+  if (size > arena->block_size)
+  {
+    return arena_alloc_dedicated(arena, size);
+  }
+  if (block == NULL || block->size - block->used < size)
+  {
+    block = arena_new_block(arena, arena->block_size);
+    if (block == NULL)
+    {
+      return NULL;
+    }
+  }
+
+  data = (char *)(block + 1) + block->used;
+  block->used += size;
+  arena->used += size;
+  return data;
+}
+
+void *arena_realloc(Arena *arena, void *ptr, size_t old_size, size_t new_size)
+{
+  ArenaBlock *block = NULL;
+  void *grown = NULL;
+
+  if (arena == NULL)
+  {
+    return realloc(ptr, new_size);
+  }
+  if (ptr != NULL && new_size <= old_size)
+  {
+    return ptr;
+  }
+
+  /* Si es la ultima reserva del bloque actual y cabe, crece en el sitio */
+  block = arena->blocks;
+  if (ptr != NULL && block != NULL && (char *)ptr + ALIGN_UP(old_size) == (char *)(block + 1) + block->used && ALIGN_UP(new_size) - ALIGN_UP(old_size) <= block->size - block->used)
+  {
+    arena->used += ALIGN_UP(new_size) - ALIGN_UP(old_size);
+    block->used += ALIGN_UP(new_size) - ALIGN_UP(old_size);
+    return ptr;
+  }
+
+  /* Copia a un hueco nuevo; el anterior se recupera con el almacen */
+  grown = arena_alloc(arena, new_size);
+  if (grown != NULL && ptr != NULL)
+  {
+    memcpy(grown, ptr, old_size < new_size ? old_size : new_size);
+  }
+  return grown;
+}
+
+void arena_free(Arena *arena, void *ptr)
+{
+  /* La memoria de un almacen solo se libera al destruirlo */
+  if (arena == NULL)
+  {
+    free(ptr);
+  }
+}
+
+Status arena_set_string(Arena *arena, char **field, const char *text)
+{
+  char *copy = NULL;
+
+  if (!field || !text)
+  {
+    return ERROR;
+  }
+
+  /* Copia del texto en un bloque de su tamaño exacto */
+  copy = (char *)arena_alloc(arena, (strlen(text) + 1) * sizeof(char));
+  if (!copy)
+  {
+    return ERROR;
+  }
+  strcpy(copy, text);
+  arena_free(arena, *field);
+  *field = copy;
+  return OK;
+}
+
+size_t arena_get_used(Arena *arena)
+{
+  if (!arena)
+  {
+    return 0;
+  }
+  return arena->used;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "arena_test.h"
+#include "test.h"
+#define MAX_TESTS 16
+int main(int argc, char** argv) {
+    int test = 0;
+    if (argc > 1) test = atoi(argv[1]);
+    if (test < 0 || test > MAX_TESTS) {
+        printf("Error: unknown test %d\t", test);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (test == 0 || test == 1) test1_arena_create();
+    if (test == 0 || test == 2) test2_arena_create();
+    if (test == 0 || test == 3) test1_arena_destroy();
+    if (test == 0 || test == 4) test2_arena_destroy();
+    if (test == 0 || test == 5) test1_arena_alloc();
+    if (test == 0 || test == 6) test2_arena_alloc();
+    if (test == 0 || test == 7) test3_arena_alloc();
+    if (test == 0 || test == 8) test4_arena_alloc();
+    if (test == 0 || test == 9) test1_arena_realloc();
+    if (test == 0 || test == 10) test2_arena_realloc();
+    if (test == 0 || test == 11) test3_arena_realloc();
+    if (test == 0 || test == 12) test1_arena_get_used();
+    if (test == 0 || test == 13) test2_arena_get_used();
+    if (test == 0 || test == 14) test1_arena_set_string();
+    if (test == 0 || test == 15) test2_arena_set_string();
+    if (test == 0 || test == 16) test3_arena_set_string();
+
+    PRINT_PASSED_PERCENTAGE;
+    return 0;
+}
+
+void test1_arena_create() {
+    Arena *a = arena_create(64);
+    PRINT_TEST_RESULT(a != NULL);
+    arena_destroy(a);
+}
+
+void test2_arena_create() {
+    PRINT_TEST_RESULT(arena_create(0) == NULL);
+}
+
+void test1_arena_destroy() {
+    Arena *a = arena_create(64);
+    arena_alloc(a, 10);
+    PRINT_TEST_RESULT(arena_destroy(a) == OK);
+}
+
+void test2_arena_destroy() {
+    PRINT_TEST_RESULT(arena_destroy(NULL) == ERROR);
+}
+
+void test1_arena_alloc() {
+    Arena *a = arena_create(64);
+    long *p = (long *)arena_alloc(a, 4 * sizeof(long));
+    PRINT_TEST_RESULT(p != NULL && p[0] == 0 && p[3] == 0);
+    arena_destroy(a);
+}
+
+void test2_arena_alloc() {
+    Arena *a = arena_create(16);
+    char *big = (char *)arena_alloc(a, 1000);
+    char *small = (char *)arena_alloc(a, 3);
+    memset(big, 'x', 1000);
+    PRINT_TEST_RESULT(big != NULL && small != NULL && small[0] == 0);
+    arena_destroy(a);
+}
+
+void test3_arena_alloc() {
+    char *p = (char *)arena_alloc(NULL, 8);
+    PRINT_TEST_RESULT(p != NULL && p[7] == 0);
+    arena_free(NULL, p);
+}
+
+void test4_arena_alloc() {
+    Arena *a = arena_create(64);
+    char *p = (char *)arena_alloc(a, 16);
+    char *big = (char *)arena_alloc(a, 200);
+    char *q = (char *)arena_alloc(a, 16);
+    /* La reserva grande va aparte y la siguiente sigue en el bloque actual */
+    PRINT_TEST_RESULT(big != NULL && big[199] == 0 && q == p + 16);
+    arena_destroy(a);
+}
+
+void test1_arena_realloc() {
+    Arena *a = arena_create(64);
+    char *p = (char *)arena_alloc(a, 4);
+    strcpy(p, "abc");
+    p = (char *)arena_realloc(a, p, 4, 200);
+    PRINT_TEST_RESULT(p != NULL && strcmp(p, "abc") == 0);
+    arena_destroy(a);
+}
+
+void test2_arena_realloc() {
+    char *p = (char *)arena_alloc(NULL, 4);
+    strcpy(p, "abc");
+    p = (char *)arena_realloc(NULL, p, 4, 200);
+    PRINT_TEST_RESULT(p != NULL && strcmp(p, "abc") == 0);
+    arena_free(NULL, p);
+}
+
+void test3_arena_realloc() {
+    Arena *a = arena_create(64);
+    char *p = (char *)arena_alloc(a, 16);
+    char *q = NULL;
+    strcpy(p, "abc");
+    /* La ultima reserva del bloque crece en el sitio */
+    q = (char *)arena_realloc(a, p, 16, 48);
+    PRINT_TEST_RESULT(q == p && strcmp(q, "abc") == 0 && arena_get_used(a) == 48);
+    arena_destroy(a);
+}
+
+void test1_arena_get_used() {
+    Arena *a = arena_create(64);
+    arena_alloc(a, 1);
+    PRINT_TEST_RESULT(arena_get_used(a) >= 1);
+    arena_destroy(a);
+}
+
+void test2_arena_get_used() {
+    PRINT_TEST_RESULT(arena_get_used(NULL) == 0);
+}
+
+void test1_arena_set_string() {
+    Arena *a = arena_create(64);
+    char *s = NULL;
+    arena_set_string(a, &s, "Espada");
+    PRINT_TEST_RESULT(arena_set_string(a, &s, "Escudo") == OK && strcmp(s, "Escudo") == 0);
+    arena_destroy(a);
+}
+
+void test2_arena_set_string() {
+    char *s = NULL;
+    /* Sin almacen la cadena anterior se libera en el heap */
+    arena_set_string(NULL, &s, "Espada");
+    PRINT_TEST_RESULT(arena_set_string(NULL, &s, "Escudo") == OK && strcmp(s, "Escudo") == 0);
+    arena_free(NULL, s);
+}
+
+void test3_arena_set_string() {
+    char *s = NULL;
+    arena_set_string(NULL, &s, "Espada");
+    PRINT_TEST_RESULT(arena_set_string(NULL, &s, NULL) == ERROR && strcmp(s, "Espada") == 0);
+    arena_free(NULL, s);
+}
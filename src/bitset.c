@@ -0,0 +1,203 @@
+/**
+ * @brief Implementa el conjunto de posiciones en mapa de bits
+ *
+ * @file bitset.c
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "bitset.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORD_BITS ((int)(CHAR_BIT * sizeof(unsigned long)))
+#define MIN_WORDS 1
+
+/**
+ * @brief Bitset
+ * Palabras de bits: la posición i es el bit i % WORD_BITS de la palabra i / WORD_BITS.
+ */
+struct _Bitset
+{
+  unsigned long *words; /*!< Palabras del mapa */
+  int n_words;          /*!< Número de palabras reservadas */
+  Arena *arena;         /*!< Almacén del que sale la memoria (NULL si es del heap) */
+};
+
+Status bitset_resize(Bitset *bitset, int n_words);
+
+Bitset *bitset_create(int n_bits)
+{
+  return bitset_create_in(NULL, n_bits);
+}
+
+Bitset *bitset_create_in(Arena *arena, int n_bits)
+{
+  Bitset *bitset = NULL;
+
+  if (n_bits < 0)
+  {
+    return NULL;
+  }
+
+  bitset = (Bitset *)arena_alloc(arena, sizeof(Bitset));
+  /* Comprueba si falla la reserva de memoria */
+  if (bitset == NULL)
+  {
+    return NULL;
+  }
+
+  bitset->arena = arena;
+  bitset->words = NULL;
+  bitset->n_words = 0;
+  if (bitset_resize(bitset, n_bits > 0 ? (n_bits + WORD_BITS - 1) / WORD_BITS : MIN_WORDS) == ERROR)
+  {
+    arena_free(arena, bitset);
+    return NULL;
+  }
+
+  return bitset;
+}
+
+Status bitset_destroy(Bitset *bitset)
+{
+  if (!bitset)
+  {
+    return ERROR;
+  }
+
+  /* Nada que liberar si sale de un almacén */
+  arena_free(bitset->arena, bitset->words);
+  arena_free(bitset->arena, bitset);
+  return OK;
+}
+
+Status bitset_resize(Bitset *bitset, int n_words)
+{
+  unsigned long *words = NULL;
+
+  words = (unsigned long *)arena_realloc(bitset->arena, bitset->words, bitset->n_words * sizeof(unsigned long), n_words * sizeof(unsigned long));
+  if (!words)
+  {
+    return ERROR;
+  }
+
+  /* Las palabras nuevas empiezan vacias */
+  if (n_words > bitset->n_words)
+  {
+    memset(words + bitset->n_words, 0, (n_words - bitset->n_words) * sizeof(unsigned long));
+  }
+  bitset->words = words;
+  bitset->n_words = n_words;
+  return OK;
+}
+
+Status bitset_add(Bitset *bitset, int index)
+{
+  int n_words;
+
+  if (!bitset || index < 0)
+  {
+    return ERROR;
+  }
+
+  /* Duplica las palabras hasta que quepa la posicion */
+  if (index / WORD_BITS >= bitset->n_words)
+  {
+    for (n_words = 2 * bitset->n_words; index / WORD_BITS >= n_words; n_words *= 2)
+      ;
+    if (bitset_resize(bitset, n_words) == ERROR)
+    {
+      return ERROR;
+    }
+  }
+
+  bitset->words[index / WORD_BITS] |= 1UL << (index % WORD_BITS);
+  return OK;
+}
+
+Status bitset_del(Bitset *bitset, int index)
+{
+  if (bitset_contains(bitset, index) == FALSE)
+  {
+    return ERROR;
+  }
+
+  bitset->words[index / WORD_BITS] &= ~(1UL << (index % WORD_BITS));
+  return OK;
+}
+
+BOOL bitset_contains(Bitset *bitset, int index)
+{
+  /* Las posiciones fuera de las palabras reservadas nunca se han añadido */
+  if (!bitset || index < 0 || index / WORD_BITS >= bitset->n_words)
+  {
+    return FALSE;
+  }
+
+  return (bitset->words[index / WORD_BITS] >> (index % WORD_BITS)) & 1UL ? TRUE : FALSE;
+}
+
+int bitset_count(Bitset *bitset)
+{
+  unsigned long word;
+  int i, count = 0;
+
+  if (!bitset)
+  {
+    return -1;
+  }
+
+  for (i = 0; i < bitset->n_words; i++)
+  {
+    /* Cada vuelta apaga el bit encendido mas bajo */
+    for (word = bitset->words[i]; word != 0; word &= word - 1)
+    {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+Status bitset_and(Bitset *dst, Bitset *src)
+{
+  int i;
+
+  if (!dst || !src)
+  {
+    return ERROR;
+  }
+
+  /* Las palabras de dst que src no tiene quedan vacias */
+  for (i = 0; i < dst->n_words; i++)
+  {
+    dst->words[i] &= (i < src->n_words) ? src->words[i] : 0UL;
+  }
+
+  return OK;
+}
+
+BOOL bitset_intersects(Bitset *a, Bitset *b)
+{
+  int i;
+
+  if (!a || !b)
+  {
+    return FALSE;
+  }
+
+  for (i = 0; i < a->n_words && i < b->n_words; i++)
+  {
+    if (a->words[i] & b->words[i])
+    {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
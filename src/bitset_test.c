@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "bitset.h"
+#include "bitset_test.h"
+#include "test.h"
+#define MAX_TESTS 16
+int main(int argc, char** argv) {
+    int test = 0;
+    if (argc > 1) test = atoi(argv[1]);
+    if (test < 0 || test > MAX_TESTS) {
+        printf("Error: unknown test %d\t", test);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (test == 0 || test == 1) test1_bitset_create();
+    if (test == 0 || test == 2) test2_bitset_create();
+    if (test == 0 || test == 3) test1_bitset_destroy();
+    if (test == 0 || test == 4) test2_bitset_destroy();
+    if (test == 0 || test == 5) test1_bitset_add();
+    if (test == 0 || test == 6) test2_bitset_add();
+    if (test == 0 || test == 7) test3_bitset_add();
+    if (test == 0 || test == 8) test1_bitset_del();
+    if (test == 0 || test == 9) test2_bitset_del();
+    if (test == 0 || test == 10) test1_bitset_contains();
+    if (test == 0 || test == 11) test2_bitset_contains();
+    if (test == 0 || test == 12) test1_bitset_count();
+    if (test == 0 || test == 13) test1_bitset_and();
+    if (test == 0 || test == 14) test1_bitset_intersects();
+    if (test == 0 || test == 15) test2_bitset_intersects();
+    if (test == 0 || test == 16) test3_bitset_create();
+
+    PRINT_PASSED_PERCENTAGE;
+    return 0;
+}
+
+void test1_bitset_create() {
+    Bitset *b = bitset_create(10);
+    PRINT_TEST_RESULT(b != NULL && bitset_count(b) == 0);
+    bitset_destroy(b);
+}
+
+void test2_bitset_create() {
+    PRINT_TEST_RESULT(bitset_create(-1) == NULL);
+}
+
+void test3_bitset_create() {
+    Arena *a = arena_create(256);
+    Bitset *b = bitset_create_in(a, 10);
+    /* Crecer dentro del almacen conserva los bits ya puestos */
+    PRINT_TEST_RESULT(b != NULL && bitset_add(b, 3) == OK && bitset_add(b, 5000) == OK && bitset_contains(b, 3) == TRUE && bitset_contains(b, 5000) == TRUE && bitset_count(b) == 2);
+    arena_destroy(a);
+}
+
+void test1_bitset_destroy() {
+    Bitset *b = bitset_create(10);
+    PRINT_TEST_RESULT(bitset_destroy(b) == OK);
+}
+
+void test2_bitset_destroy() {
+    PRINT_TEST_RESULT(bitset_destroy(NULL) == ERROR);
+}
+
+void test1_bitset_add() {
+    Bitset *b = bitset_create(10);
+    PRINT_TEST_RESULT(bitset_add(b, 3) == OK && bitset_contains(b, 3) == TRUE);
+    bitset_destroy(b);
+}
+
+void test2_bitset_add() {
+    Bitset *b = bitset_create(10);
+    PRINT_TEST_RESULT(bitset_add(b, -1) == ERROR);
+    bitset_destroy(b);
+}
+
+void test3_bitset_add() {
+    Bitset *b = bitset_create(0);
+    int i, ok = 1;
+    /* Posiciones muy por encima de la capacidad inicial */
+    for (i = 0; i < 1000; i += 7) {
+        if (bitset_add(b, i) != OK) ok = 0;
+    }
+    for (i = 0; i < 1000; i++) {
+        if (bitset_contains(b, i) != (i % 7 == 0 ? TRUE : FALSE)) ok = 0;
+    }
+    PRINT_TEST_RESULT(ok);
+    bitset_destroy(b);
+}
+
+void test1_bitset_del() {
+    Bitset *b = bitset_create(10);
+    bitset_add(b, 5);
+    PRINT_TEST_RESULT(bitset_del(b, 5) == OK && bitset_contains(b, 5) == FALSE);
+    bitset_destroy(b);
+}
+
+void test2_bitset_del() {
+    Bitset *b = bitset_create(10);
+    PRINT_TEST_RESULT(bitset_del(b, 5) == ERROR && bitset_del(b, 5000) == ERROR);
+    bitset_destroy(b);
+}
+
+void test1_bitset_contains() {
+    Bitset *b = bitset_create(10);
+    bitset_add(b, 2);
+    PRINT_TEST_RESULT(bitset_contains(b, 3) == FALSE && bitset_contains(b, 5000) == FALSE);
+    bitset_destroy(b);
+}
+
+void test2_bitset_contains() {
+    PRINT_TEST_RESULT(bitset_contains(NULL, 0) == FALSE);
+}
+
+void test1_bitset_count() {
+    Bitset *b = bitset_create(10);
+    bitset_add(b, 0);
+    bitset_add(b, 63);
+    bitset_add(b, 64);
+    bitset_add(b, 200);
+    bitset_add(b, 200);
+    PRINT_TEST_RESULT(bitset_count(b) == 4);
+    bitset_destroy(b);
+}
+
+void test1_bitset_and() {
+    Bitset *a = bitset_create(10), *b = bitset_create(10);
+    bitset_add(a, 1);
+    bitset_add(a, 2);
+    bitset_add(a, 300);
+    bitset_add(b, 2);
+    bitset_add(b, 3);
+    PRINT_TEST_RESULT(bitset_and(a, b) == OK && bitset_count(a) == 1 && bitset_contains(a, 2) == TRUE);
+    bitset_destroy(a);
+    bitset_destroy(b);
+}
+
+void test1_bitset_intersects() {
+    Bitset *a = bitset_create(10), *b = bitset_create(10);
+    bitset_add(a, 100);
+    bitset_add(b, 100);
+    PRINT_TEST_RESULT(bitset_intersects(a, b) == TRUE);
+    bitset_destroy(a);
+    bitset_destroy(b);
+}
+
+void test2_bitset_intersects() {
+    Bitset *a = bitset_create(10), *b = bitset_create(10);
+    bitset_add(a, 1);
+    bitset_add(b, 2);
+    PRINT_TEST_RESULT(bitset_intersects(a, b) == FALSE);
+    bitset_destroy(a);
+    bitset_destroy(b);
+}
@@ -20,11 +20,17 @@ struct _Character
     char gdesc[10];                    /*!< Descripción gráfica */
     int health;                        /*!< Puntos de salud */
     int friendly;                      /*!< Indica si es amistoso */
-    char message[100];                 /*!< Mensaje asociado al personaje */
+    char *message;                     /*!< Mensaje asociado al personaje (reservado a su medida) */
     Id following;                      /*!< Id de la entidad a la que sigue */
+    Arena *arena;                      /*!< Almacén del que sale la memoria (NULL si es del heap) */
 };
 
 Character *character_create(Id id)
+{
+    return character_create_in(NULL, id);
+}
+
+Character *character_create_in(Arena *arena, Id id)
 {
     Character *newCharacter = NULL;
 
@@ -32,7 +38,7 @@ Character *character_create(Id id)
     if (id == NO_ID)
         return NULL;
 
-    newCharacter = (Character *)malloc(sizeof(Character));
+    newCharacter = (Character *)arena_alloc(arena, sizeof(Character));
 
     /* Comprueba si falla la reserva de memoria */
     if (newCharacter == NULL)
@@ -42,12 +48,13 @@ Character *character_create(Id id)
 
     /* Inicializa los datos del personaje */
     newCharacter->id = id;
+    newCharacter->arena = arena;
 
     newCharacter->name[0] = '\0';
     newCharacter->gdesc[0] = '\0';
     newCharacter->health = 0;
     newCharacter->friendly = 0;
-    newCharacter->message[0] = '\0';
+    newCharacter->message = NULL;
     newCharacter->following = NO_ID;
 
     return newCharacter;
@@ -58,7 +65,8 @@ void character_destroy(Character *character)
     /* Libera la memoria del personaje si existe */
     if (character != NULL)
     {
-        free(character);
+        arena_free(character->arena, character->message);
+        arena_free(character->arena, character);
     }
 }
 
@@ -72,6 +80,16 @@ Id character_get_id(Character *character)
     return character->id;
 }
 
+Arena *character_get_arena(Character *character)
+{
+    /* Devuelve el almacen o NULL si hay error */
+    if (!character)
+    {
+        return NULL;
+    }
+    return character->arena;
+}
+
 char *character_get_name(Character *character)
 {
     /* Devuelve el nombre del personaje */
@@ -177,20 +195,17 @@ char *character_get_message(Character *character)
     {
         return NULL;
     }
-    return character->message;
+    return character->message ? character->message : "";
 }
 
 Status character_set_message(Character *character, char *message)
 {
-    /* Comprueba que el personaje y el mensaje existan */
-    if (!character || !message)
+    /* Comprueba que el personaje exista y copia su mensaje */
+    if (!character)
     {
         return ERROR;
     }
-
-    /* Copia el mensaje del personaje */
-    strcpy(character->message, message);
-    return OK;
+    return arena_set_string(character->arena, &character->message, message);
 }
 Id character_get_following(Character* character)
 {
@@ -217,6 +232,6 @@ void character_print(Character *character)
     if (character != NULL)
     {
         printf("--> Character (Id: %ld; Name: %s; Gdesc: %s; Health: %d; Friendly: %d; Message: %s; Following:%ld)\n",
-               character->id, character->name, character->gdesc, character->health, character->friendly, character->message, character->following);
+               character->id, character->name, character->gdesc, character->health, character->friendly, character_get_message(character), character->following);
     }
 }
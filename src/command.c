@@ -11,6 +11,7 @@
 #include "command.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <ctype.h>
 #include <string.h>
 #include <strings.h>
 
@@ -18,7 +19,13 @@
 #define SINGLE_ELEM 1
 #define MAX_ARGS 3
 
-char *cmd_to_str[N_CMD][N_CMDT] = {{"", "No command"}, {"", "Unknown"}, {"e", "exit"}, {"t", "Take"}, {"d", "drop"}, {"a", "attack"}, {"c", "chat"}, {"m", "move"}, {"i", "inspect"}, {"r", "recruit"}, {"ab", "abandon"}, {"u", "use"}, {"o", "open"},{"s", "save"},{"l","load"}};
+/*
+ * Las palabras salen de command_words.h y sus tablas de huecos de
+ * command_slots.h, generado con make slots a partir de la misma lista.
+ */
+#include "command_words.h"
+#include "command_slots.h"
+
 struct _Command
 {
   CommandCode code;            /*!<  Codigo del comando enumerado */
@@ -27,6 +34,30 @@ struct _Command
   char last_input[CMD_LENGHT]; /*!< Almacena la ultima entrada completa del usuario */
 };
 
+char *command_next_token(char **cursor, const char *delims);
+int command_word_find(const char *word, const char *const (*words)[N_CMDT], const signed char *slots, int n_slots);
+
+char *command_next_token(char **cursor, const char *delims)
+{
+  char *token = NULL;
+
+  /* Como strtok, pero con el estado en el llamante en lugar de en una variable estatica */
+  token = *cursor + strspn(*cursor, delims);
+  if (*token == '\0')
+  {
+    *cursor = token;
+    return NULL;
+  }
+
+  *cursor = token + strcspn(token, delims);
+  if (**cursor != '\0')
+  {
+    **cursor = '\0';
+    (*cursor)++;
+  }
+  return token;
+}
+
 Command *command_create()
 {
   Command *newCommand = NULL;
@@ -114,90 +145,140 @@ char *command_get_last_input(Command *command)
 
 Status command_get_user_input(Command *command)
 {
-  char input[CMD_LENGHT] = "", *token = NULL, *arg = NULL;
-  int i = UNKNOWN - NO_CMD + 1;
-  CommandCode cmd;
+  return command_get_input_from(command, stdin);
+}
 
-  /* Comprueba la validez del comando */
-  if (!command)
+Status command_get_input_from(Command *command, FILE *stream)
+{
+  char input[CMD_LENGHT] = "";
+
+  /* Comprueba la validez del comando y del flujo */
+  if (!command || !stream)
   {
     return ERROR;
   }
 
-  /* Lee la entrada del usuario desde el flujo estándar */
-  if (fgets(input, CMD_LENGHT, stdin))
+  /* Lee la siguiente linea del flujo de entrada */
+  if (fgets(input, CMD_LENGHT, stream))
   {
-    for (i = 0; i < MAX_ARGS; i++)
-    {
-      command->args[i][0] = '\0';
-    }
-    command->n_args = 0;
-
-    strncpy(command->last_input, input, CMD_LENGHT - 1);
+    return command_parse_input(command, input);
+  }
+  else
+  {
+    /* Asigna comando de salida en caso de fin de archivo (EOF) */
+    strncpy(command->last_input, "exit", CMD_LENGHT - 1);
     command->last_input[CMD_LENGHT - 1] = '\0';
+    return command_set_code(command, EXIT);
+  }
+}
 
-    /* Extrae el primer token correspondiente al comando */
-    token = strtok(input, " \n");
+Status command_parse_input(Command *command, char *line)
+{
+  char input[CMD_LENGHT] = "", *token = NULL, *arg = NULL, *cursor = NULL;
+  int i, row;
+  CommandCode cmd;
 
-    /* Si la entrada esta vacia, asigna codigo desconocido */
-    if (!token)
-    {
-      return command_set_code(command, UNKNOWN);
-    }
+  /* Comprueba la validez del comando y de la linea */
+  if (!command || !line)
+  {
+    return ERROR;
+  }
 
-    cmd = UNKNOWN;
-    i = UNKNOWN - NO_CMD + 1;
+  /* Copia la linea para no modificar el buffer del llamante */
+  strncpy(input, line, CMD_LENGHT - 1);
+  input[CMD_LENGHT - 1] = '\0';
 
-    /* Busca coincidencia del token con los comandos validos */
-    while (cmd == UNKNOWN && i < N_CMD)
-    {
-      if (!strcasecmp(token, cmd_to_str[i][CMDS]) || !strcasecmp(token, cmd_to_str[i][CMDL]))
-      {
-        cmd = i + NO_CMD;
-      }
-      else
-      {
-        i++;
-      }
-    }
+  for (i = 0; i < MAX_ARGS; i++)
+  {
+    command->args[i][0] = '\0';
+  }
+  command->n_args = 0;
+
+  strncpy(command->last_input, input, CMD_LENGHT - 1);
+  command->last_input[CMD_LENGHT - 1] = '\0';
+
+  /* Extrae el primer token correspondiente al comando */
+  cursor = input;
+  token = command_next_token(&cursor, " \r\n");
+
+  /* Si la entrada esta vacia, asigna codigo desconocido */
+  if (!token)
+  {
+    return command_set_code(command, UNKNOWN);
+  }
+
+  /* Busca el token en la tabla de verbos */
+  row = command_word_find(token, cmd_to_str, verb_slots, VERB_SLOTS);
+  cmd = (row >= 0) ? (CommandCode)(row + NO_CMD) : UNKNOWN;
 
-    /* Extrae el segundo token correspondiente al argumento */
-    arg = strtok(NULL, "\n");
+  /* Extrae el segundo token correspondiente al argumento */
+  arg = command_next_token(&cursor, "\r\n");
 
-    if (arg)
+  if (arg)
+  {
+    i = 0;
+    cursor = arg;
+    token = command_next_token(&cursor, " ");
+    if (token != NULL)
     {
-      i = 0;
-      token = strtok(arg, " ");
-      if (token != NULL)
+      command->n_args = 1;
+      strcpy(command->args[i], token);
+      while (token != NULL && i < MAX_ARGS)
       {
-        command->n_args = 1;
-        strcpy(command->args[i], token);
-        while (token != NULL && i < MAX_ARGS)
+        i++;
+        token = command_next_token(&cursor, " ");
+        if (token == NULL)
+        {
+          break;
+        }
+        if (i < MAX_ARGS)
         {
-          i++;
-          token = strtok(NULL, " ");
-          if (token == NULL)
-          {
-            break;
-          }
-          if (i < MAX_ARGS)
-          {
-            strcpy(command->args[i], token);
-            command->n_args++;
-          }
+          strcpy(command->args[i], token);
+          command->n_args++;
         }
       }
     }
+  }
 
-    return command_set_code(command, cmd);
+  return command_set_code(command, cmd);
+}
+
+int command_word_find(const char *word, const char *const (*words)[N_CMDT], const signed char *slots, int n_slots)
+{
+  const char *c = NULL;
+  int slot;
+
+  if (!word || word[0] == '\0')
+  {
+    return -1;
   }
-  else
+
+  /* Una sola pasada: primera y ultima letra y longitud deciden el hueco */
+  for (c = word; c[1] != '\0'; c++)
+    ;
+  slot = slots[COMMAND_WORD_SLOT(tolower((unsigned char)word[0]), tolower((unsigned char)*c), (int)(c - word + 1), n_slots)];
+
+  /* El hueco solo puede contener esa palabra: basta una comparacion */
+  if (slot < 0 || strcasecmp(word, words[slot / N_CMDT][slot % N_CMDT]) != 0)
   {
-    /* Asigna comando de salida en caso de fin de archivo (EOF) */
-    strncpy(command->last_input, "exit", CMD_LENGHT - 1);
-    command->last_input[CMD_LENGHT - 1] = '\0';
-    return command_set_code(command, EXIT);
+    return -1;
+  }
+  return slot / N_CMDT;
+}
+
+Directions command_str_to_direction(const char *str)
+{
+  return (Directions)command_word_find(str, dir_to_str, direction_slots, DIRECTION_SLOTS);
+}
+
+const char *command_code_to_str(CommandCode code, CommandType type)
+{
+  /* Comprueba que el codigo y el formato esten dentro de la tabla */
+  if (code < NO_CMD || code - NO_CMD >= N_CMD || (type != CMDS && type != CMDL))
+  {
+    return "";
   }
+  return cmd_to_str[code - NO_CMD][type];
 }
 
 int command_get_nargs(Command *command)
@@ -0,0 +1,105 @@
+/**
+ * @brief Genera las tablas de huecos de verbos y direcciones
+ *
+ * Escribe en la salida estándar el contenido de command_slots.h a partir de
+ * las listas de command_words.h (make slots). Para cada lista elige la
+ * menor tabla, potencia de dos y de al menos el doble de palabras, en la
+ * que COMMAND_WORD_SLOT no lleva dos palabras al mismo hueco.
+ *
+ * @file command_slots.c
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include "command_words.h"
+
+#define MAX_SLOTS 1024
+#define SLOTS_PER_ROW 16
+
+int command_slots_build(const char *const (*words)[N_CMDT], int first_row, int n_rows, signed char *slots);
+void command_slots_print(const char *name, const char *size_name, signed char *slots, int n_slots);
+
+int command_slots_build(const char *const (*words)[N_CMDT], int first_row, int n_rows, signed char *slots)
+{
+  const char *word = NULL;
+  int n_slots, row, type, len, slot;
+
+  /* Empieza con el doble de huecos que palabras y duplica mientras haya colisiones */
+  for (n_slots = 1; n_slots < 2 * N_CMDT * (n_rows - first_row); n_slots *= 2)
+    ;
+  for (; n_slots <= MAX_SLOTS; n_slots *= 2)
+  {
+    memset(slots, -1, n_slots);
+    for (row = first_row; row < n_rows; row++)
+    {
+      for (type = 0; type < N_CMDT; type++)
+      {
+        word = words[row][type];
+        len = (int)strlen(word);
+        if (len == 0)
+        {
+          continue;
+        }
+        slot = COMMAND_WORD_SLOT(tolower((unsigned char)word[0]), tolower((unsigned char)word[len - 1]), len, n_slots);
+        if (slots[slot] >= 0)
+        {
+          break;
+        }
+        slots[slot] = (signed char)(row * N_CMDT + type);
+      }
+      if (type < N_CMDT)
+      {
+        break;
+      }
+    }
+    if (row == n_rows)
+    {
+      return n_slots;
+    }
+  }
+
+  return -1;
+}
+
+void command_slots_print(const char *name, const char *size_name, signed char *slots, int n_slots)
+{
+  int i;
+
+  printf("#define %s %d\n", size_name, n_slots);
+  printf("static const signed char %s[%s] = {", name, size_name);
+  for (i = 0; i < n_slots; i++)
+  {
+    printf("%s%2d%s", i % SLOTS_PER_ROW == 0 ? "\n  " : " ", slots[i], i < n_slots - 1 ? "," : "};\n");
+  }
+}
+
+int main(void)
+{
+  signed char verb_slots[MAX_SLOTS], direction_slots[MAX_SLOTS];
+  int n_verb_slots, n_direction_slots;
+
+  /*
+   * NO_CMD y UNKNOWN no se escriben: los verbos empiezan en EXIT. Una
+   * palabra repetida colisiona consigo misma en cualquier tabla.
+   */
+  n_verb_slots = command_slots_build(cmd_to_str, EXIT - NO_CMD, N_CMD, verb_slots);
+  n_direction_slots = command_slots_build(dir_to_str, 0, N_DIR_WORDS, direction_slots);
+  if (n_verb_slots < 0 || n_direction_slots < 0 || N_CMD * N_CMDT > 127)
+  {
+    fprintf(stderr, "Error: no perfect hash for the keyword lists in command_words.h.\n");
+    return 1;
+  }
+
+  printf("/* Generado por command_slots a partir de command_words.h (make slots): no editar */\n\n");
+  printf("#ifndef COMMAND_SLOTS_H\n#define COMMAND_SLOTS_H\n\n");
+  command_slots_print("verb_slots", "VERB_SLOTS", verb_slots, n_verb_slots);
+  printf("\n");
+  command_slots_print("direction_slots", "DIRECTION_SLOTS", direction_slots, n_direction_slots);
+  printf("\n#endif\n");
+  return 0;
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "command.h"
+#include "command_test.h"
+#include "test.h"
+#define MAX_TESTS 9
+int main(int argc, char** argv) {
+    int test = 0;
+    if (argc > 1) test = atoi(argv[1]);
+    if (test < 0 || test > MAX_TESTS) {
+        printf("Error: unknown test %d\t", test);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (test == 0 || test == 1) test1_command_parse_input();
+    if (test == 0 || test == 2) test2_command_parse_input();
+    if (test == 0 || test == 3) test3_command_parse_input();
+    if (test == 0 || test == 4) test4_command_parse_input();
+    if (test == 0 || test == 5) test5_command_parse_input();
+    if (test == 0 || test == 6) test1_command_str_to_direction();
+    if (test == 0 || test == 7) test2_command_str_to_direction();
+    if (test == 0 || test == 8) test3_command_str_to_direction();
+    if (test == 0 || test == 9) test4_command_str_to_direction();
+
+    PRINT_PASSED_PERCENTAGE;
+    return 0;
+}
+
+void test1_command_parse_input() {
+    Command *c = command_create();
+    char line[32];
+    int code, ok = 1;
+    /* Todos los nombres cortos y largos de la tabla de comandos se reconocen */
+    for (code = EXIT; code <= LOAD; code++) {
+        sprintf(line, "%s\n", command_code_to_str((CommandCode)code, CMDS));
+        command_parse_input(c, line);
+        if (command_get_code(c) != code) ok = 0;
+        sprintf(line, "%s\n", command_code_to_str((CommandCode)code, CMDL));
+        command_parse_input(c, line);
+        if (command_get_code(c) != code) ok = 0;
+    }
+    PRINT_TEST_RESULT(ok);
+    command_destroy(c);
+}
+
+void test2_command_parse_input() {
+    Command *c = command_create();
+    command_parse_input(c, "InSpEcT Daga\n");
+    PRINT_TEST_RESULT(command_get_code(c) == INSPECT && strcmp(command_get_arg(c)[0], "Daga") == 0);
+    command_destroy(c);
+}
+
+void test3_command_parse_input() {
+    Command *c = command_create();
+    int ok = 1;
+    /* Palabras que comparten hueco o prefijo con un verbo */
+    command_parse_input(c, "ex\n");
+    if (command_get_code(c) != UNKNOWN) ok = 0;
+    command_parse_input(c, "takes\n");
+    if (command_get_code(c) != UNKNOWN) ok = 0;
+    command_parse_input(c, "unknown\n");
+    if (command_get_code(c) != UNKNOWN) ok = 0;
+    PRINT_TEST_RESULT(ok);
+    command_destroy(c);
+}
+
+void test4_command_parse_input() {
+    Command *c = command_create();
+    command_parse_input(c, "\n");
+    PRINT_TEST_RESULT(command_get_code(c) == UNKNOWN);
+    command_destroy(c);
+}
+
+void test5_command_parse_input() {
+    Command *c = command_create();
+    PRINT_TEST_RESULT(command_parse_input(c, NULL) == ERROR);
+    command_destroy(c);
+}
+
+void test1_command_str_to_direction() {
+    const char *names[] = {"n", "north", "s", "south", "e", "east", "w", "west", "u", "up", "d", "down"};
+    Directions dirs[] = {N, N, S, S, E, E, W, W, U, U, D, D};
+    int i, ok = 1;
+    for (i = 0; i < 12; i++) {
+        if (command_str_to_direction(names[i]) != dirs[i]) ok = 0;
+    }
+    PRINT_TEST_RESULT(ok);
+}
+
+void test2_command_str_to_direction() {
+    PRINT_TEST_RESULT(command_str_to_direction("NoRtH") == N);
+}
+
+void test3_command_str_to_direction() {
+    PRINT_TEST_RESULT(command_str_to_direction("exit") == NO_DIRECTION && command_str_to_direction("") == NO_DIRECTION);
+}
+
+void test4_command_str_to_direction() {
+    PRINT_TEST_RESULT(command_str_to_direction(NULL) == NO_DIRECTION);
+}
@@ -19,74 +19,306 @@
 #include <string.h>
 #include <strings.h>
 #include "game_managment.h"
+#include "id_map.h"
+#include "arena.h"
+#include "bitset.h"
 
 #define PLAYER_ID 0
 #define FIRST_POSITION 0
-#define MAX_OBJECTS 100
-#define MAX_LINKS 800
-#define MAX_PLAYERS 8
+#define INIT_CAPACITY 16
+#define INIT_PLAYERS 2
+#define ARENA_BLOCK_SIZE 65536
+#define DEFAULT_SEED 1UL
+#define RNG_MASK 0xffffffffUL
 
+/**
+ * @brief Party
+ * Seguidores de un jugador, como posiciones en characters en orden creciente.
+ */
+typedef struct
+{
+  int *members;  /*!< Posiciones de los personajes que siguen al jugador */
+  int n_members; /*!< Numero de seguidores */
+  int capacity;  /*!< Huecos reservados en members */
+} Party;
+
+/*
+ * Las tablas de entidades son vectores dinamicos: cuando se llenan se
+ * duplica su capacidad, de modo que cada insercion cuesta O(1) amortizado.
+ * Los campos que se recorren para todo el mundo (ubicacion, salud,
+ * seguimiento) se guardan ademas en columnas paralelas a objects y
+ * characters, para que esos barridos lean memoria contigua.
+ *
+ * Solo estas columnas usan posiciones densas. Los conjuntos de cada Space,
+ * la mochila y los enlaces siguen guardando Ids, porque es lo que exponen
+ * sus modulos; las posiciones se obtienen con los indices *_index.
+ */
 struct _Game
 {
-  Player *players[MAX_PLAYERS];          /*!< Array de punteros a jugadores */
+  Player **players;                      /*!< Array de punteros a jugadores */
   int turn;                              /*!< Numero de turno actual */
-  Object *objects[MAX_OBJECTS];          /*!< Array de punteros a objetos */
-  Character *characters[MAX_CHARACTERS]; /*!< Array de punteros a personajes */
-  Space *spaces[MAX_SPACES];             /*!< Array de punteros a espacios */
+  Object **objects;                      /*!< Array de punteros a objetos */
+  Character **characters;                /*!< Array de punteros a personajes */
+  Space **spaces;                        /*!< Array de punteros a espacios */
   int n_spaces;                          /*!< Contador de espacios cargados */
   int n_players;                         /*!< Numero actual de jugadores */
-  Link *link[MAX_LINKS];                 /*!< Array de punteros a enlaces */
+  Link **link;                           /*!< Array de punteros a enlaces */
   int n_links;                           /*!< Contador de enlaces cargados */
   int finished;                          /*!< Bandera de finalizacion del juego */
   char object_inspection[WORD_SIZE];     /*!< Descripcion del objeto activo */
-  char messages[MAX_PLAYERS][WORD_SIZE]; /*!< Array de mensajes por jugador */
+  char (*messages)[WORD_SIZE];           /*!< Array de mensajes por jugador */
   Command *last_command;                 /*!< Puntero al ultimo comando procesado */
   Status last_status;                    /*!< Estado del ultimo comando procesado */
   int n_characters;                      /*!< Contador de personajes cargados */
   int n_objects;                         /*!< Contador de objetos cargados */
+  int players_capacity;                  /*!< Huecos reservados en players y messages */
+  int objects_capacity;                  /*!< Huecos reservados en objects */
+  int characters_capacity;               /*!< Huecos reservados en characters */
+  int spaces_capacity;                   /*!< Huecos reservados en spaces */
+  int links_capacity;                    /*!< Huecos reservados en link */
+  Id *followers;                         /*!< Buffer de seguidores del jugador activo */
+  int followers_capacity;                /*!< Huecos reservados en followers */
+  IdMap *space_index;                    /*!< Indice hash Id -> posicion en spaces */
+  IdMap *object_index;                   /*!< Indice hash Id -> posicion en objects */
+  IdMap *character_index;                /*!< Indice hash Id -> posicion en characters */
+  IdMap *link_index;                     /*!< Indice hash Id -> posicion en link */
+  int *object_spaces;                    /*!< Columna de posiciones en spaces de los objetos, -1 si no estan */
+  Id *character_ids;                     /*!< Columna de Ids de los personajes */
+  int *character_spaces;                 /*!< Columna de posiciones en spaces de los personajes, -1 si no estan */
+  int *character_health;                 /*!< Columna de salud de los personajes */
+  Id *character_following;               /*!< Columna de a quien sigue cada personaje */
+  Bitset **space_objects;                /*!< Columna de objetos de cada espacio, por posicion en objects (en arena) */
+  Bitset **player_objects;               /*!< Columna de objetos de la mochila de cada jugador, por posicion en objects (en arena) */
+  Party *parties;                        /*!< Columna de seguidores de cada jugador */
+  Arena *arena;                          /*!< Almacen de las entidades creadas por el cargador */
+  BOOL heap_entities;                    /*!< Alguna entidad anadida esta en el heap y se libera por separado */
+  unsigned long rng_state;               /*!< Estado del generador aleatorio propio (xorshift de 32 bits) */
 };
 
 Status game_add_space(Game *game, Space *space);
 Id game_get_space_id_at(Game *game, int position);
+void *game_grow_array(void *array, int *capacity, size_t elem_size);
+Status game_index_put(IdMap *index, Id id, int position);
+void game_destroy_indices(Game *game);
+Status game_grow_objects(Game *game);
+Status game_grow_characters(Game *game);
+Status game_grow_spaces(Game *game);
+Id game_get_space_id_or_none(Game *game, int position);
+int game_get_player_position(Game *game, Id player_id);
+Status game_party_add(Party *party, int position);
+void game_party_del(Party *party, int position);
+
+void *game_grow_array(void *array, int *capacity, size_t elem_size)
+{
+  void *grown = NULL;
+  int new_capacity;
 
-Status game_create(Game **game)
+  /* Duplica la capacidad (o reserva la inicial si el array esta vacio) */
+  new_capacity = (*capacity > 0) ? 2 * (*capacity) : INIT_CAPACITY;
+  grown = realloc(array, new_capacity * elem_size);
+  if (!grown)
+  {
+    return NULL;
+  }
+
+  *capacity = new_capacity;
+  return grown;
+}
+
+Status game_index_put(IdMap *index, Id id, int position)
 {
-  int i;
+  /* Ante Ids repetidos prevalece la primera entidad cargada */
+  if (id == NO_ID || id_map_get(index, id) != ID_MAP_NOT_FOUND)
+  {
+    return OK;
+  }
+  return id_map_put(index, id, position);
+}
 
-  /* Comprueba la integridad del puntero al juego */
-  if (!game)
+void game_destroy_indices(Game *game)
+{
+  id_map_destroy(game->space_index);
+  id_map_destroy(game->object_index);
+  id_map_destroy(game->character_index);
+  id_map_destroy(game->link_index);
+}
+
+Status game_grow_objects(Game *game)
+{
+  Object **objects = NULL;
+  int *spaces = NULL, capacity = game->objects_capacity;
+
+  /* El vector de punteros y sus columnas crecen a la vez */
+  objects = (Object **)game_grow_array(game->objects, &capacity, sizeof(Object *));
+  if (!objects)
   {
     return ERROR;
   }
+  game->objects = objects;
 
-  *game = (Game *)malloc(sizeof(Game));
-  /* Comprueba si la reserva del bloque principal falla */
-  if (!*game)
+  spaces = (int *)realloc(game->object_spaces, capacity * sizeof(int));
+  if (!spaces)
+  {
+    return ERROR;
+  }
+  game->object_spaces = spaces;
+
+  game->objects_capacity = capacity;
+  return OK;
+}
+
+Status game_grow_characters(Game *game)
+{
+  Character **characters = NULL;
+  Id *ids = NULL, *following = NULL;
+  int *spaces = NULL, *health = NULL, capacity = game->characters_capacity;
+
+  /* El vector de punteros y sus columnas crecen a la vez */
+  characters = (Character **)game_grow_array(game->characters, &capacity, sizeof(Character *));
+  if (!characters)
   {
     return ERROR;
   }
+  game->characters = characters;
 
-  /* Limpieza e inicializacion de arrays de componentes */
-  for (i = 0; i < MAX_SPACES; i++)
+  ids = (Id *)realloc(game->character_ids, capacity * sizeof(Id));
+  if (!ids)
   {
-    (*game)->spaces[i] = NULL;
+    return ERROR;
   }
-  for (i = 0; i < MAX_OBJECTS; i++)
+  game->character_ids = ids;
+
+  spaces = (int *)realloc(game->character_spaces, capacity * sizeof(int));
+  if (!spaces)
   {
-    (*game)->objects[i] = NULL;
+    return ERROR;
   }
-  for (i = 0; i < MAX_CHARACTERS; i++)
+  game->character_spaces = spaces;
+
+  health = (int *)realloc(game->character_health, capacity * sizeof(int));
+  if (!health)
   {
-    (*game)->characters[i] = NULL;
+    return ERROR;
   }
-  for (i = 0; i < MAX_LINKS; i++)
+  game->character_health = health;
+
+  following = (Id *)realloc(game->character_following, capacity * sizeof(Id));
+  if (!following)
+  {
+    return ERROR;
+  }
+  game->character_following = following;
+
+  game->characters_capacity = capacity;
+  return OK;
+}
+
+Status game_grow_spaces(Game *game)
+{
+  Space **spaces = NULL;
+  Bitset **objects = NULL;
+  int capacity = game->spaces_capacity;
+
+  /* El vector de punteros y su columna crecen a la vez */
+  spaces = (Space **)game_grow_array(game->spaces, &capacity, sizeof(Space *));
+  if (!spaces)
   {
-    (*game)->link[i] = NULL;
+    return ERROR;
   }
-  for (i = 0; i < MAX_PLAYERS; i++)
+  game->spaces = spaces;
+
+  objects = (Bitset **)realloc(game->space_objects, capacity * sizeof(Bitset *));
+  if (!objects)
   {
-    (*game)->players[i] = NULL;
-    (*game)->messages[i][0] = '\0';
+    return ERROR;
+  }
+  game->space_objects = objects;
+
+  game->spaces_capacity = capacity;
+  return OK;
+}
+
+int game_get_player_position(Game *game, Id player_id)
+{
+  int i;
+
+  /* Hay muy pocos jugadores: basta con recorrerlos */
+  for (i = 0; player_id != NO_ID && i < game->n_players; i++)
+  {
+    if (player_get_id(game->players[i]) == player_id)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+Status game_party_add(Party *party, int position)
+{
+  int *members = NULL, i;
+
+  if (party->n_members >= party->capacity)
+  {
+    members = (int *)game_grow_array(party->members, &party->capacity, sizeof(int));
+    if (!members)
+    {
+      return ERROR;
+    }
+    party->members = members;
+  }
+
+  /* Insercion ordenada: los seguidores salen en el orden de characters */
+  for (i = party->n_members; i > 0 && party->members[i - 1] > position; i--)
+  {
+    party->members[i] = party->members[i - 1];
+  }
+  party->members[i] = position;
+  party->n_members++;
+  return OK;
+}
+
+void game_party_del(Party *party, int position)
+{
+  int i;
+
+  for (i = 0; i < party->n_members && party->members[i] != position; i++)
+    ;
+  if (i == party->n_members)
+  {
+    return;
+  }
+
+  for (; i < party->n_members - 1; i++)
+  {
+    party->members[i] = party->members[i + 1];
+  }
+  party->n_members--;
+}
+
+Id game_get_space_id_or_none(Game *game, int position)
+{
+  /* Las columnas guardan -1 para las entidades que no estan en ningun espacio */
+  if (position < 0)
+  {
+    return NO_ID;
+  }
+  return space_get_id(game->spaces[position]);
+}
+
+Status game_create(Game **game)
+{
+  /* Comprueba la integridad del puntero al juego */
+  if (!game)
+  {
+    return ERROR;
+  }
+
+  /* Los arrays de componentes empiezan vacios (NULL, capacidad 0) */
+  *game = (Game *)calloc(1, sizeof(Game));
+  /* Comprueba si la reserva del bloque principal falla */
+  if (!*game)
+  {
+    return ERROR;
   }
 
   /* Asignacion de estados predeterminados */
@@ -98,8 +330,26 @@ Status game_create(Game **game)
   (*game)->n_players = 0;
   (*game)->n_objects = 0;
   (*game)->n_characters = 0;
+  (*game)->heap_entities = FALSE;
   (*game)->last_command = command_create();
   (*game)->last_status = OK;
+  game_set_seed(*game, DEFAULT_SEED);
+
+  /* Indices densos Id -> posicion de cada tipo de entidad */
+  (*game)->space_index = id_map_create(INIT_CAPACITY);
+  (*game)->object_index = id_map_create(INIT_CAPACITY);
+  (*game)->character_index = id_map_create(INIT_CAPACITY);
+  (*game)->link_index = id_map_create(INIT_CAPACITY);
+  (*game)->arena = arena_create(ARENA_BLOCK_SIZE);
+  if (!(*game)->space_index || !(*game)->object_index || !(*game)->character_index || !(*game)->link_index || !(*game)->arena)
+  {
+    arena_destroy((*game)->arena);
+    game_destroy_indices(*game);
+    command_destroy((*game)->last_command);
+    free(*game);
+    *game = NULL;
+    return ERROR;
+  }
 
   return OK;
 }
@@ -118,25 +368,11 @@ Status game_create_from_file(Game **game, char *filename)
     return ERROR;
   }
 
-  /* Delegacion modular de la carga de las entidades */
-  if (game_managment_load_spaces(*game, filename) == ERROR)
-  {
-    return ERROR;
-  }
-  if (game_managment_load_players(*game, filename) == ERROR)
-  {
-    return ERROR;
-  }
-  if (game_managment_load_objects(*game, filename) == ERROR)
-  {
-    return ERROR;
-  }
-  if (game_managment_load_links(*game, filename) == ERROR)
-  {
-    return ERROR;
-  }
-  if (game_managment_load_characters(*game, filename) == ERROR)
+  /* Carga de todas las entidades en una unica lectura del archivo */
+  if (game_managment_load_game(*game, filename) == ERROR)
   {
+    game_destroy(*game);
+    *game = NULL;
     return ERROR;
   }
 
@@ -153,57 +389,88 @@ Status game_destroy(Game *game)
     return ERROR;
   }
 
-  /* Destruccion escalonada de entidades */
-  for (i = 0; i < game->n_spaces; i++)
+  /*
+   * Las entidades del almacen se liberan con el al final: solo se recorren
+   * una a una si alguna se creo en el heap (su destruir no toca las demas).
+   */
+  if (game->heap_entities == TRUE)
   {
-    space_destroy(game->spaces[i]);
-  }
+    for (i = 0; i < game->n_spaces; i++)
+    {
+      space_destroy(game->spaces[i]);
+    }
 
-  for (i = 0; i < game->n_players; i++)
-  {
-    if (game->players[i])
+    for (i = 0; i < game->n_players; i++)
     {
       player_destroy(game->players[i]);
     }
-  }
 
-  for (i = 0; i < game->n_links; i++)
-  {
-    if (game->link[i])
+    for (i = 0; i < game->n_links; i++)
     {
       link_destroy(game->link[i]);
     }
-  }
 
-  for (i = 0; i < game->n_objects; i++)
-  {
-    if (game->objects[i])
+    for (i = 0; i < game->n_objects; i++)
     {
       object_destroy(game->objects[i]);
     }
-  }
 
-  for (i = 0; i < game->n_characters; i++)
-  {
-    if (game->characters[i])
+    for (i = 0; i < game->n_characters; i++)
     {
       character_destroy(game->characters[i]);
     }
   }
 
+  for (i = 0; i < game->n_players; i++)
+  {
+    free(game->parties[i].members);
+  }
+
   if (game->last_command)
   {
     command_destroy(game->last_command);
   }
 
+  game_destroy_indices(game);
+
+  /* Liberacion de los vectores dinamicos de entidades */
+  free(game->spaces);
+  free(game->players);
+  free(game->messages);
+  free(game->link);
+  free(game->objects);
+  free(game->characters);
+  free(game->followers);
+  free(game->object_spaces);
+  free(game->character_ids);
+  free(game->character_spaces);
+  free(game->character_health);
+  free(game->character_following);
+  free(game->space_objects);
+  free(game->player_objects);
+  free(game->parties);
+
+  /* Todas las entidades del cargador se liberan de una vez con el almacen */
+  arena_destroy(game->arena);
+
   /* Liberacion del bloque padre */
   free(game);
   return OK;
 }
 
+Arena *game_get_arena(Game *game)
+{
+  /* Comprueba la validez del juego */
+  if (!game)
+  {
+    return NULL;
+  }
+  return game->arena;
+}
+
 Space *game_get_space(Game *game, Id id)
 {
-  int i;
+  int position;
 
   /* Comprueba la validez de los parametros */
   if (id == NO_ID || !game)
@@ -211,22 +478,20 @@ Space *game_get_space(Game *game, Id id)
     return NULL;
   }
 
-  /* Busqueda secuencial del espacio por identificador */
-  for (i = 0; i < game->n_spaces; i++)
+  /* Traduce el identificador a su posicion densa */
+  position = id_map_get(game->space_index, id);
+  if (position == ID_MAP_NOT_FOUND)
   {
-    if (id == space_get_id(game->spaces[i]))
-    {
-      return game->spaces[i];
-    }
+    return NULL;
   }
 
-  return NULL;
+  return game->spaces[position];
 }
 
 Id game_get_player_location(Game *game)
 {
-  /* Comprueba la validez del juego */
-  if (!game)
+  /* Comprueba la validez del juego y que haya jugador en turno */
+  if (!game || game->n_players <= 0 || game->turn >= game->n_players)
   {
     return NO_ID;
   }
@@ -235,8 +500,8 @@ Id game_get_player_location(Game *game)
 
 Status game_set_player_location(Game *game, Id id)
 {
-  /* Comprueba la validez de los parametros */
-  if (id == NO_ID || !game)
+  /* Comprueba la validez de los parametros y que haya jugador en turno */
+  if (id == NO_ID || !game || game->n_players <= 0 || game->turn >= game->n_players)
   {
     return ERROR;
   }
@@ -245,131 +510,252 @@ Status game_set_player_location(Game *game, Id id)
 
 Id game_get_object_location(Game *game, Id object_id)
 {
-  int i;
+  /* Columna de ubicaciones en la posicion densa del objeto */
+  return game_get_object_location_at(game, game_get_object_index(game, object_id));
+}
 
+Id game_get_object_location_at(Game *game, int position)
+{
   /* Comprueba la validez de los parametros */
-  if (!game || object_id == NO_ID)
+  if (!game || position < 0 || position >= game->n_objects)
   {
     return NO_ID;
   }
+  return game_get_space_id_or_none(game, game->object_spaces[position]);
+}
 
-  /* Itera sobre los espacios para localizar el objeto */
-  for (i = 0; i < game->n_spaces; i++)
+Status game_set_object_location(Game *game, Id space_id, Id object_id)
+{
+  int object;
+
+  /* Comprueba la validez de los parametros; un espacio desconocido equivale a ninguno */
+  object = game_get_object_index(game, object_id);
+  if (object == ID_MAP_NOT_FOUND)
   {
-    if (space_contains_object(game->spaces[i], object_id) == OK)
-    {
-      return space_get_id(game->spaces[i]);
-    }
+    return ERROR;
   }
-  return NO_ID;
+  return game_set_object_location_at(game, object, game_get_space_index(game, space_id));
 }
 
-Status game_set_object_location(Game *game, Id space_id, Id object_id)
+Status game_set_object_location_at(Game *game, int object, int space)
 {
-  Id loc_actual;
-  int i;
+  Id object_id;
+  Status status = OK;
 
-  /* Comprueba la validez de los parametros */
-  if (!game || object_id == NO_ID)
+  /* Comprueba la validez de las posiciones */
+  if (!game || object < 0 || object >= game->n_objects || space < -1 || space >= game->n_spaces)
   {
     return ERROR;
   }
+  object_id = object_get_id(game->objects[object]);
 
   /* Eliminacion de la ubicacion previa del objeto */
-  loc_actual = game_get_object_location(game, object_id);
-  if (loc_actual != NO_ID)
+  if (game->object_spaces[object] >= 0)
   {
-    for (i = 0; i < game->n_spaces; i++)
-    {
-      if (space_get_id(game->spaces[i]) == loc_actual)
-      {
-        space_remove_object(game->spaces[i], object_id);
-        break;
-      }
-    }
+    space_remove_object(game->spaces[game->object_spaces[object]], object_id);
+    bitset_del(game->space_objects[game->object_spaces[object]], object);
+    game->object_spaces[object] = -1;
   }
 
   /* Insercion del objeto en la nueva ubicacion */
-  if (space_id != NO_ID)
+  if (space >= 0)
   {
-    for (i = 0; i < game->n_spaces; i++)
+    status = space_add_object(game->spaces[space], object_id);
+    if (status == OK && bitset_add(game->space_objects[space], object) == ERROR)
     {
-      if (space_get_id(game->spaces[i]) == space_id)
-      {
-        return space_add_object(game->spaces[i], object_id);
-      }
+      space_remove_object(game->spaces[space], object_id);
+      status = ERROR;
     }
+    if (status == OK)
+    {
+      game->object_spaces[object] = space;
+    }
+  }
+
+  return status;
+}
+
+BOOL game_space_has_object(Game *game, Id space_id, Id object_id)
+{
+  int space;
+
+  /* Un bit de la columna del espacio, sin recorrer su conjunto */
+  space = game_get_space_index(game, space_id);
+  if (space == ID_MAP_NOT_FOUND)
+  {
+    return FALSE;
+  }
+  return bitset_contains(game->space_objects[space], game_get_object_index(game, object_id));
+}
+
+BOOL game_player_has_object(Game *game, Id object_id)
+{
+  /* Comprueba la validez del juego y que haya jugadores */
+  if (!game || game->n_players <= 0)
+  {
+    return FALSE;
   }
+  return bitset_contains(game->player_objects[game->turn], game_get_object_index(game, object_id));
+}
 
+Status game_player_add_object(Game *game, Id object_id)
+{
+  int object;
+
+  /* Comprueba la validez de los parametros y que haya jugadores */
+  object = game_get_object_index(game, object_id);
+  if (object == ID_MAP_NOT_FOUND || game->n_players <= 0)
+  {
+    return ERROR;
+  }
+
+  /* La mochila y su columna se actualizan juntas */
+  if (player_add_object(game->players[game->turn], object_id) == ERROR)
+  {
+    return ERROR;
+  }
+  if (bitset_add(game->player_objects[game->turn], object) == ERROR)
+  {
+    player_del_object(game->players[game->turn], object_id);
+    return ERROR;
+  }
   return OK;
 }
 
-Id game_get_character_location(Game *game, Id character_id)
+Status game_player_del_object(Game *game, Id object_id)
 {
-  int i, j;
+  int object;
 
-  /* Comprueba la validez de los parametros */
-  if (!game || character_id == NO_ID)
+  /* Comprueba la validez de los parametros y que haya jugadores */
+  object = game_get_object_index(game, object_id);
+  if (object == ID_MAP_NOT_FOUND || game->n_players <= 0)
   {
-    return NO_ID;
+    return ERROR;
   }
 
-  /* Itera sobre los espacios para localizar al personaje */
-  for (i = 0; i < game->n_spaces; i++)
+  /* La mochila y su columna se actualizan juntas */
+  if (player_del_object(game->players[game->turn], object_id) == ERROR)
   {
-    for (j = 0; j < space_get_n_characters(game->spaces[i]); j++)
-    {
+    return ERROR;
+  }
+  bitset_del(game->player_objects[game->turn], object);
+  return OK;
+}
 
-      if (space_get_character(game->spaces[i], j) == character_id)
-      {
-        return space_get_id(game->spaces[i]);
-      }
-    }
+Id game_get_character_location(Game *game, Id character_id)
+{
+  /* Columna de ubicaciones en la posicion densa del personaje */
+  return game_get_character_location_at(game, game_get_character_index(game, character_id));
+}
+
+Id game_get_character_location_at(Game *game, int position)
+{
+  /* Comprueba la validez de los parametros */
+  if (!game || position < 0 || position >= game->n_characters)
+  {
+    return NO_ID;
   }
-  return NO_ID;
+  return game_get_space_id_or_none(game, game->character_spaces[position]);
 }
 
 Status game_set_character_location(Game *game, Id space_id, Id character_id)
 {
-  Id loc_actual;
-  int i;
+  int character;
 
-  /* Comprueba la validez de los parametros */
-  if (!game || character_id == NO_ID)
+  /* Comprueba la validez de los parametros; un espacio desconocido equivale a ninguno */
+  character = game_get_character_index(game, character_id);
+  if (character == ID_MAP_NOT_FOUND)
   {
     return ERROR;
   }
+  return game_set_character_location_at(game, character, game_get_space_index(game, space_id));
+}
+
+Status game_set_character_location_at(Game *game, int character, int space)
+{
+  Id character_id;
+  Status status = OK;
 
-  loc_actual = game_get_character_location(game, character_id);
+  /* Comprueba la validez de las posiciones */
+  if (!game || character < 0 || character >= game->n_characters || space < -1 || space >= game->n_spaces)
+  {
+    return ERROR;
+  }
+  character_id = game->character_ids[character];
 
   /* Eliminacion de la ubicacion previa del personaje */
-  if (loc_actual != NO_ID)
+  if (game->character_spaces[character] >= 0)
   {
-    for (i = 0; i < game->n_spaces; i++)
+    if (space_remove_character(game->spaces[game->character_spaces[character]], character_id) == ERROR)
     {
-      if (space_get_id(game->spaces[i]) == loc_actual)
-      {
-        if (space_remove_character(game->spaces[i], character_id) == ERROR)
-        {
-          return ERROR;
-        }
-        break;
-      }
+      return ERROR;
     }
+    game->character_spaces[character] = -1;
   }
 
   /* Insercion del personaje en la nueva ubicacion */
-  if (space_id != NO_ID)
+  if (space >= 0)
   {
-    for (i = 0; i < game->n_spaces; i++)
+    status = space_set_character(game->spaces[space], character_id);
+    if (status == OK)
     {
-      if (space_get_id(game->spaces[i]) == space_id)
-      {
-        return space_set_character(game->spaces[i], character_id);
-      }
+      game->character_spaces[character] = space;
     }
   }
 
+  return status;
+}
+
+int game_get_character_health_at(Game *game, int position)
+{
+  /* Comprueba la validez de los parametros */
+  if (!game || position < 0 || position >= game->n_characters)
+  {
+    return 0;
+  }
+  return game->character_health[position];
+}
+
+Status game_set_character_health(Game *game, Id character_id, int health)
+{
+  int position;
+
+  /* El personaje y su columna se actualizan juntos */
+  position = game_get_character_index(game, character_id);
+  if (position == ID_MAP_NOT_FOUND || character_set_health(game->characters[position], health) == ERROR)
+  {
+    return ERROR;
+  }
+  game->character_health[position] = health;
+  return OK;
+}
+
+Status game_set_character_following(Game *game, Id character_id, Id following)
+{
+  int position, old_player, new_player;
+
+  /* Comprueba la validez de los parametros */
+  position = game_get_character_index(game, character_id);
+  if (position == ID_MAP_NOT_FOUND)
+  {
+    return ERROR;
+  }
+
+  /* El personaje pasa del grupo del jugador anterior al del nuevo */
+  old_player = game_get_player_position(game, game->character_following[position]);
+  new_player = game_get_player_position(game, following);
+  if (new_player >= 0 && new_player != old_player && game_party_add(&game->parties[new_player], position) == ERROR)
+  {
+    return ERROR;
+  }
+  if (old_player >= 0 && old_player != new_player)
+  {
+    game_party_del(&game->parties[old_player], position);
+  }
+
+  /* El personaje y su columna se actualizan juntos */
+  character_set_following(game->characters[position], following);
+  game->character_following[position] = following;
   return OK;
 }
 
@@ -444,8 +830,8 @@ void game_print(Game *game)
 {
   int i;
 
-  /* Comprueba la validez del juego antes de imprimir */
-  if (!game)
+  /* Comprueba la validez del juego y que haya jugador en turno antes de imprimir */
+  if (!game || game->n_players <= 0 || game->turn >= game->n_players)
   {
     return;
   }
@@ -459,7 +845,7 @@ void game_print(Game *game)
 
   player_print(game->players[game->turn]);
 
-  for (i = 0; i < MAX_OBJECTS; i++)
+  for (i = 0; i < game->n_objects; i++)
   {
     if (game->objects[i])
     {
@@ -467,7 +853,7 @@ void game_print(Game *game)
     }
   }
 
-  for (i = 0; i < MAX_CHARACTERS; i++)
+  for (i = 0; i < game->n_characters; i++)
   {
     if (game->characters[i])
     {
@@ -476,7 +862,7 @@ void game_print(Game *game)
   }
 
   fprintf(stdout, "---> Links:\n");
-  for (i = 0; i < MAX_LINKS; i++)
+  for (i = 0; i < game->n_links; i++)
   {
     if (game->link[i] != NULL)
     {
@@ -487,8 +873,8 @@ void game_print(Game *game)
 
 Player *game_get_player(Game *game)
 {
-  /* Comprueba la validez del juego */
-  if (!game)
+  /* Comprueba la validez del juego y que haya jugador en turno */
+  if (!game || game->n_players <= 0 || game->turn >= game->n_players)
   {
     return NULL;
   }
@@ -497,57 +883,148 @@ Player *game_get_player(Game *game)
 
 Status game_set_player(Game *game, Player *player)
 {
-  /* Comprueba la validez y capacidad de jugadores */
-  if (!game || !player || game->n_players >= MAX_PLAYERS)
+  Player **players = NULL;
+  char (*messages)[WORD_SIZE] = NULL;
+  Bitset **objects = NULL;
+  Party *parties = NULL;
+  int new_capacity, i;
+
+  /* Comprueba la validez de los parametros */
+  if (!game || !player)
   {
     return ERROR;
   }
 
+  /* Amplia a la vez los jugadores y sus mensajes si estan llenos */
+  if (game->n_players >= game->players_capacity)
+  {
+    new_capacity = (game->players_capacity > 0) ? 2 * game->players_capacity : INIT_PLAYERS;
+    players = (Player **)realloc(game->players, new_capacity * sizeof(Player *));
+    if (!players)
+    {
+      return ERROR;
+    }
+    game->players = players;
+
+    messages = realloc(game->messages, new_capacity * sizeof(*messages));
+    if (!messages)
+    {
+      return ERROR;
+    }
+    game->messages = messages;
+
+    objects = (Bitset **)realloc(game->player_objects, new_capacity * sizeof(Bitset *));
+    if (!objects)
+    {
+      return ERROR;
+    }
+    game->player_objects = objects;
+
+    parties = (Party *)realloc(game->parties, new_capacity * sizeof(Party));
+    if (!parties)
+    {
+      return ERROR;
+    }
+    game->parties = parties;
+    game->players_capacity = new_capacity;
+  }
+
+  /* Los objetos de la mochila, por posicion densa, para comprobarlos con un bit */
+  game->player_objects[game->n_players] = bitset_create_in(game->arena, game->n_objects);
+  if (!game->player_objects[game->n_players])
+  {
+    return ERROR;
+  }
+
+  /* Personajes que ya seguian a este jugador antes de que se cargara */
+  parties = &game->parties[game->n_players];
+  parties->members = NULL;
+  parties->n_members = 0;
+  parties->capacity = 0;
+  for (i = 0; i < game->n_characters; i++)
+  {
+    if (game->character_following[i] == player_get_id(player) && game_party_add(parties, i) == ERROR)
+    {
+      free(parties->members);
+      bitset_destroy(game->player_objects[game->n_players]);
+      return ERROR;
+    }
+  }
+
+  game->messages[game->n_players][0] = '\0';
   game->players[game->n_players] = player;
+  if (player_get_arena(player) != game->arena)
+  {
+    game->heap_entities = TRUE;
+  }
   game->n_players++;
   return OK;
 }
 
 Object *game_get_object(Game *game, Id id)
 {
-  int i;
+  int position;
 
-  /* Comprueba la validez de los parametros */
-  if (!game || id == NO_ID)
+  /* Traduce el identificador a su posicion densa */
+  position = game_get_object_index(game, id);
+  if (position == ID_MAP_NOT_FOUND)
   {
     return NULL;
   }
+  return game->objects[position];
+}
 
-  /* Busca el objeto por identificador */
-  for (i = 0; i < MAX_OBJECTS; i++)
+Character *game_get_character(Game *game, Id id)
+{
+  int position;
+
+  /* Traduce el identificador a su posicion densa */
+  position = game_get_character_index(game, id);
+  if (position == ID_MAP_NOT_FOUND)
   {
-    if (game->objects[i] != NULL && object_get_id(game->objects[i]) == id)
-    {
-      return game->objects[i];
-    }
+    return NULL;
   }
-  return NULL;
+  return game->characters[position];
 }
 
-Character *game_get_character(Game *game, Id id)
+int game_get_space_index(Game *game, Id id)
 {
-  int i;
+  /* Comprueba la validez de los parametros */
+  if (!game || id == NO_ID)
+  {
+    return ID_MAP_NOT_FOUND;
+  }
+  return id_map_get(game->space_index, id);
+}
 
+int game_get_object_index(Game *game, Id id)
+{
   /* Comprueba la validez de los parametros */
   if (!game || id == NO_ID)
   {
-    return NULL;
+    return ID_MAP_NOT_FOUND;
   }
+  return id_map_get(game->object_index, id);
+}
 
-  /* Busca el personaje por identificador */
-  for (i = 0; i < MAX_CHARACTERS; i++)
+int game_get_character_index(Game *game, Id id)
+{
+  /* Comprueba la validez de los parametros */
+  if (!game || id == NO_ID)
   {
-    if (game->characters[i] != NULL && character_get_id(game->characters[i]) == id)
-    {
-      return game->characters[i];
-    }
+    return ID_MAP_NOT_FOUND;
   }
-  return NULL;
+  return id_map_get(game->character_index, id);
+}
+
+int game_get_link_index(Game *game, Id id)
+{
+  /* Comprueba la validez de los parametros */
+  if (!game || id == NO_ID)
+  {
+    return ID_MAP_NOT_FOUND;
+  }
+  return id_map_get(game->link_index, id);
 }
 
 Character *game_get_character_at(Game *game, int position)
@@ -563,40 +1040,125 @@ Character *game_get_character_at(Game *game, int position)
 
 Status game_add_object(Game *game, Object *obj)
 {
-  /* Comprueba la validez y capacidad de objetos */
-  if (!game || !obj || game->n_objects >= MAX_OBJECTS)
+  /* Comprueba la validez de los parametros */
+  if (!game || !obj)
+  {
+    return ERROR;
+  }
+
+  /* Amplia el vector de objetos si esta lleno */
+  if (game->n_objects >= game->objects_capacity && game_grow_objects(game) == ERROR)
+  {
+    return ERROR;
+  }
+
+  /* Registro de la posicion densa del objeto */
+  if (game_index_put(game->object_index, object_get_id(obj), game->n_objects) == ERROR)
   {
     return ERROR;
   }
 
   game->objects[game->n_objects] = obj;
+  if (object_get_arena(obj) != game->arena)
+  {
+    game->heap_entities = TRUE;
+  }
+  game->object_spaces[game->n_objects] = -1;
   game->n_objects++;
   return OK;
 }
 
 Status game_add_character(Game *game, Character *character)
 {
-  /* Comprueba la validez y capacidad de personajes */
-  if (!game || !character || game->n_characters >= MAX_CHARACTERS)
+  int player;
+
+  /* Comprueba la validez de los parametros */
+  if (!game || !character)
   {
     return ERROR;
   }
 
+  /* Amplia el vector de personajes si esta lleno */
+  if (game->n_characters >= game->characters_capacity && game_grow_characters(game) == ERROR)
+  {
+    return ERROR;
+  }
+
+  /* Si ya sigue a un jugador cargado entra en su grupo */
+  player = game_get_player_position(game, character_get_following(character));
+  if (player >= 0 && game_party_add(&game->parties[player], game->n_characters) == ERROR)
+  {
+    return ERROR;
+  }
+
+  /* Registro de la posicion densa del personaje */
+  if (game_index_put(game->character_index, character_get_id(character), game->n_characters) == ERROR)
+  {
+    if (player >= 0)
+    {
+      game_party_del(&game->parties[player], game->n_characters);
+    }
+    return ERROR;
+  }
+
   game->characters[game->n_characters] = character;
+  if (character_get_arena(character) != game->arena)
+  {
+    game->heap_entities = TRUE;
+  }
+  game->character_ids[game->n_characters] = character_get_id(character);
+  game->character_spaces[game->n_characters] = -1;
+  game->character_health[game->n_characters] = character_get_health(character);
+  game->character_following[game->n_characters] = character_get_following(character);
   game->n_characters++;
   return OK;
 }
 
 Status game_add_space(Game *game, Space *space)
 {
-  /* Comprueba la validez y capacidad de espacios */
-  if ((space == NULL) || (game->n_spaces >= MAX_SPACES))
+  int i;
+
+  /* Comprueba la validez de los parametros */
+  if (!game || space == NULL)
+  {
+    return ERROR;
+  }
+
+  /* Amplia el vector de espacios si esta lleno */
+  if (game->n_spaces >= game->spaces_capacity && game_grow_spaces(game) == ERROR)
   {
     return ERROR;
   }
 
+  /* Los objetos del espacio, por posicion densa, para comprobarlos con un bit */
+  game->space_objects[game->n_spaces] = bitset_create_in(game->arena, game->n_objects);
+  if (!game->space_objects[game->n_spaces])
+  {
+    return ERROR;
+  }
+
+  /* Registro de la posicion densa del espacio */
+  if (game_index_put(game->space_index, space_get_id(space), game->n_spaces) == ERROR)
+  {
+    bitset_destroy(game->space_objects[game->n_spaces]);
+    return ERROR;
+  }
+
   game->spaces[game->n_spaces] = space;
+  if (space_get_arena(space) != game->arena)
+  {
+    game->heap_entities = TRUE;
+  }
   game->n_spaces++;
+
+  /* Enlaces cargados antes que su espacio de origen */
+  for (i = 0; i < game->n_links; i++)
+  {
+    if (link_get_origin(game->link[i]) == space_get_id(space))
+    {
+      space_add_link(space, game->link[i]);
+    }
+  }
   return OK;
 }
 
@@ -612,8 +1174,8 @@ Id game_get_space_id_at(Game *game, int position)
 
 Status game_set_chat_message(Game *game, char *message)
 {
-  /* Comprueba la validez de los parametros */
-  if (!game || !message)
+  /* Comprueba la validez de los parametros y que haya jugadores */
+  if (!game || !message || game->n_players <= 0)
   {
     return ERROR;
   }
@@ -624,8 +1186,8 @@ Status game_set_chat_message(Game *game, char *message)
 
 char *game_get_chat_message(Game *game)
 {
-  /* Comprueba la validez del juego */
-  if (!game)
+  /* Comprueba la validez del juego y que haya jugadores */
+  if (!game || game->n_players <= 0)
   {
     return NULL;
   }
@@ -634,98 +1196,96 @@ char *game_get_chat_message(Game *game)
 
 Id game_get_connection(Game *game, Id space_id, Directions dir)
 {
-  int i;
-
   /* Comprueba la validez de los parametros */
   if (!game || space_id == NO_ID || dir == NO_DIRECTION)
   {
     return NO_ID;
   }
 
-  /* Busca la conexion especifica en el array de enlaces */
-  for (i = 0; i < game->n_links; i++)
-  {
-    if (link_get_origin(game->link[i]) == space_id && link_get_direction(game->link[i]) == dir)
-    {
-      return link_get_destination(game->link[i]);
-    }
-  }
-  return NO_ID;
+  /* Lectura de la tabla de adyacencia del espacio de origen */
+  return link_get_destination(space_get_link_at(game_get_space(game, space_id), dir));
 }
 
 BOOL game_connection_is_open(Game *game, Id space_id, Directions dir)
 {
-  Link *l = NULL;
-  int i;
-
   /* Comprueba la validez de los parametros */
   if (!game || space_id == NO_ID || dir == NO_DIRECTION)
   {
     return FALSE;
   }
 
-  /* Obtiene el enlace solicitado */
-  for (i = 0; i < game->n_links; i++)
+  /* Obtiene el enlace solicitado de la tabla de adyacencia */
+  return link_get_open(space_get_link_at(game_get_space(game, space_id), dir));
+}
+
+Status game_add_link(Game *game, Link *link)
+{
+  /* Comprueba la validez de los parametros; el origen puede no estar cargado aun */
+  if (!game || !link)
   {
-    if ((link_get_origin(game->link[i]) == space_id) && (link_get_direction(game->link[i]) == dir))
-    {
-      l = game->link[i];
-      break;
-    }
+    return ERROR;
   }
-
-  return link_get_open(l);
+  return game_add_link_at(game, link, game_get_space_index(game, link_get_origin(link)));
 }
 
-Status game_add_link(Game *game, Link *link)
+Status game_add_link_at(Game *game, Link *link, int origin)
 {
-  int i;
+  Link **links = NULL;
 
   /* Comprueba la validez de los parametros */
-  if (!game || !link)
+  if (!game || !link || origin < -1 || origin >= game->n_spaces)
   {
     return ERROR;
   }
 
-  /* Itera para encontrar un espacio libre en el array */
-  for (i = 0; i < MAX_LINKS; i++)
+  /* Amplia el vector de enlaces si esta lleno */
+  if (game->n_links >= game->links_capacity)
   {
-    if (game->link[i] == NULL)
+    links = (Link **)game_grow_array(game->link, &game->links_capacity, sizeof(Link *));
+    if (!links)
     {
-      game->link[i] = link;
-      game->n_links++;
-      return OK;
+      return ERROR;
     }
+    game->link = links;
   }
 
-  return ERROR;
+  /* Registro de la posicion densa del enlace */
+  if (game_index_put(game->link_index, link_get_id(link), game->n_links) == ERROR)
+  {
+    return ERROR;
+  }
+
+  game->link[game->n_links] = link;
+  if (link_get_arena(link) != game->arena)
+  {
+    game->heap_entities = TRUE;
+  }
+  game->n_links++;
+
+  /* Registro en la tabla de adyacencia del origen, si ya esta cargado */
+  if (origin >= 0)
+  {
+    space_add_link(game->spaces[origin], link);
+  }
+  return OK;
 }
 
 Link *game_get_link(Game *game, Id link_id)
 {
-  int i;
+  int position;
 
-  /* Comprueba la validez de los parametros */
-  if (!game || link_id == NO_ID)
+  /* Traduce el identificador a su posicion densa */
+  position = game_get_link_index(game, link_id);
+  if (position == ID_MAP_NOT_FOUND)
   {
     return NULL;
   }
-
-  /* Busca el enlace por identificador */
-  for (i = 0; i < MAX_LINKS; i++)
-  {
-    if (game->link[i] != NULL && link_get_id(game->link[i]) == link_id)
-    {
-      return game->link[i];
-    }
-  }
-
-  return NULL;
+  return game->link[position];
 }
 
 Link *game_get_link_at(Game *game, int index)
 {
-  if (!game || index < 0 || index >= MAX_LINKS)
+  if (!game || index < 0 || index >= game->n_links)
   {
     return NULL;
   }
@@ -767,6 +1327,43 @@ void game_next_turn(Game *game)
   game->turn = (game->turn + 1) % game->n_players;
 }
 
+Status game_set_seed(Game *game, unsigned long seed)
+{
+  /* Comprueba la validez del juego */
+  if (!game)
+  {
+    return ERROR;
+  }
+
+  /* El estado 0 es un punto fijo de xorshift */
+  game->rng_state = seed & RNG_MASK;
+  if (game->rng_state == 0)
+  {
+    game->rng_state = DEFAULT_SEED;
+  }
+  return OK;
+}
+
+int game_get_random(Game *game, int max)
+{
+  unsigned long x;
+
+  /* Comprueba la validez de los parametros */
+  if (!game || max <= 0)
+  {
+    return -1;
+  }
+
+  /* xorshift de 32 bits: misma secuencia en cualquier plataforma */
+  x = game->rng_state;
+  x ^= (x << 13) & RNG_MASK;
+  x ^= x >> 17;
+  x ^= (x << 5) & RNG_MASK;
+  game->rng_state = x;
+
+  return (int)(x % (unsigned long)max);
+}
+
 Status game_set_object_desc(Game *game, const char *inspection)
 {
   /* Comprueba la validez de los parametros */
@@ -813,43 +1410,42 @@ int game_get_number_of_characters(Game *game)
 }
 int game_get_number_of_followers_of_player(Game *game)
 {
-  Id id;
-  int cont, i;
-  if (!game)
+  if (!game || game->n_players <= 0)
   {
     return -1;
   }
-  id = player_get_id(game->players[game->turn]);
-  for (i = 0, cont = 0; i < game->n_characters; i++)
-  {
-    if (id == character_get_following(game->characters[i]))
-    {
-      cont++;
-    }
-  }
-  return cont;
+  return game->parties[game->turn].n_members;
 }
 Id *game_get_players_followers(Game *game)
 {
-  static Id ids[MAX_CHARACTERS];
-  int i, cont;
-  if (!game)
+  Party *party = NULL;
+  Id *ids = NULL;
+  int i;
+  if (!game || game->n_players <= 0)
   {
     return NULL;
   }
-  for (i = 0; i < MAX_CHARACTERS; i++)
-  {
-    ids[i] = NO_ID;
-  }
 
-  for (i = 0, cont = 0; i < game->n_characters; i++)
+  /* El buffer siempre tiene un hueco mas que seguidores para el NO_ID final */
+  party = &game->parties[game->turn];
+  if (game->followers_capacity <= party->n_members)
   {
-    if (player_get_id(game_get_player(game)) == character_get_following(game->characters[i]))
+    ids = (Id *)realloc(game->followers, (party->n_members + 1) * sizeof(Id));
+    if (!ids)
     {
-      ids[cont] = character_get_id(game->characters[i]);
-      cont++;
+      return NULL;
     }
+    game->followers = ids;
+    game->followers_capacity = party->n_members + 1;
+  }
+
+  /* Solo se recorre el grupo del jugador activo */
+  ids = game->followers;
+  for (i = 0; i < party->n_members; i++)
+  {
+    ids[i] = game->character_ids[party->members[i]];
   }
+  ids[party->n_members] = NO_ID;
   return ids;
 }
 
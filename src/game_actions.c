@@ -32,6 +32,7 @@ Status game_actions_use(Game *game);
 Status game_actions_open(Game *game);
 Status game_actions_save(Game *game);
 Status game_actions_load(Game *game);
+BOOL game_actions_allows_turn_roll(CommandCode code);
 
 Status game_actions_update(Game *game, Command *command)
 {
@@ -93,6 +94,56 @@ Status game_actions_update(Game *game, Command *command)
   return status;
 }
 
+BOOL game_actions_allows_turn_roll(CommandCode code)
+{
+  switch (code)
+  {
+  case TAKE:
+  case DROP:
+  case MOVE:
+  case INSPECT:
+  case USE:
+  case OPEN:
+    return TRUE;
+  default:
+    return FALSE;
+  }
+}
+
+void game_actions_update_turn(Game *game, Command *command)
+{
+  int random_num = 0;
+  char turn_message[WORD_SIZE] = "";
+
+  if (!game || !command)
+  {
+    return;
+  }
+
+  if (game_get_last_command_status(game) == ERROR)
+  {
+    return;
+  }
+
+  if (game_actions_allows_turn_roll(command_get_code(command)) == FALSE)
+  {
+    return;
+  }
+
+  random_num = game_get_random(game, 10);
+  if (random_num <= 2)
+  {
+    game_next_turn(game);
+    sprintf(turn_message, "you rolled %d, next players turn", random_num);
+  }
+  else
+  {
+    sprintf(turn_message, "you rolled %d, you continue", random_num);
+  }
+
+  game_set_chat_message(game, turn_message);
+}
+
 Status game_actions_unknown(Game *game)
 {
   return ERROR;
@@ -106,12 +157,11 @@ Status game_actions_exit(Game *game)
 Status game_actions_move(Game *game)
 {
   Id current_space_id = NO_ID, destination_id = NO_ID;
-  Id player_id = NO_ID;
+  Id *followers = NULL;
   char **arg = NULL;
   Directions dir = NO_DIRECTION;
   Command *last_cmd = NULL;
   Space *dest_space = NULL;
-  Character *character = NULL;
   int i = 0;
 
   /* Comprueba la validez del puntero */
@@ -130,30 +180,7 @@ Status game_actions_move(Game *game)
   }
 
   /* Traduccion del argumento a la direccion enumerada */
-  if (strcasecmp(arg[0], "north") == 0 || strcasecmp(arg[0], "n") == 0)
-  {
-    dir = N;
-  }
-  else if (strcasecmp(arg[0], "south") == 0 || strcasecmp(arg[0], "s") == 0)
-  {
-    dir = S;
-  }
-  else if (strcasecmp(arg[0], "west") == 0 || strcasecmp(arg[0], "w") == 0)
-  {
-    dir = W;
-  }
-  else if (strcasecmp(arg[0], "east") == 0 || strcasecmp(arg[0], "e") == 0)
-  {
-    dir = E;
-  }
-  else if (strcasecmp(arg[0], "up") == 0 || strcasecmp(arg[0], "u") == 0)
-  {
-    dir = U;
-  }
-  else if (strcasecmp(arg[0], "down") == 0 || strcasecmp(arg[0], "d") == 0)
-  {
-    dir = D;
-  }
+  dir = command_str_to_direction(arg[0]);
 
   /* Obtiene la ubicacion actual del jugador activo */
   current_space_id = game_get_player_location(game);
@@ -177,21 +204,21 @@ Status game_actions_move(Game *game)
   /* Aplica el desplazamiento al destino */
   if (destination_id != NO_ID)
   {
-    player_id = player_get_id(game_get_player(game));
     if (game_set_player_location(game, destination_id) == ERROR)
     {
       return ERROR;
     }
 
-    for (i = 0; i < game_get_number_of_characters(game); i++)
+    /* Los seguidores del jugador se mueven con el */
+    if (!(followers = game_get_players_followers(game)))
     {
-      character = game_get_character_from_index(game, i);
-      if (character != NULL && character_get_following(character) == player_id)
+      return ERROR;
+    }
+    for (i = 0; followers[i] != NO_ID; i++)
+    {
+      if (game_set_character_location(game, destination_id, followers[i]) == ERROR)
       {
-        if (game_set_character_location(game, destination_id, character_get_id(character)) == ERROR)
-        {
-          return ERROR;
-        }
+        return ERROR;
       }
     }
 
@@ -202,7 +229,6 @@ Status game_actions_move(Game *game)
     }
     return OK;
   }
-  printf("No se ha podido mover en esa direccion.\n");
   return ERROR;
 }
 
@@ -257,7 +283,7 @@ Status game_actions_take(Game *game)
   {
     return ERROR;
   }
-  if (!space_contains_object(space, obj_id))
+  if (game_space_has_object(game, player_loc, obj_id) == FALSE)
   {
     return ERROR;
   }
@@ -273,17 +299,17 @@ Status game_actions_take(Game *game)
   if (object_get_dependency(object) != NO_ID)
   {
 
-    if (!player_has_object(player, object_get_dependency(object)))
+    if (game_player_has_object(game, object_get_dependency(object)) == FALSE)
     {
       return ERROR;
     }
   }
-  if (space_remove_object(space, obj_id) == ERROR)
+  if (game_set_object_location(game, NO_ID, obj_id) == ERROR)
   {
     return ERROR;
   }
 
-  if (player_add_object(game_get_player(game), obj_id) == ERROR)
+  if (game_player_add_object(game, obj_id) == ERROR)
   {
     return ERROR;
   }
@@ -340,11 +366,11 @@ Status game_actions_drop(Game *game)
         if (strcasecmp(object_get_name(obj), arg[0]) == 0)
         {
           /* Eliminacion y reubicacion del objeto */
-          player_del_object(game_get_player(game), obj_id);
+          game_player_del_object(game, obj_id);
           game_set_object_location(game, player_loc, obj_id);
           if ((id_2 = object_get_dependency(obj)) != NO_ID)
           {
-            player_del_object(game_get_player(game), id_2);
+            game_player_del_object(game, id_2);
             game_set_object_location(game, player_loc, id_2);
           }
           return OK;
@@ -367,7 +393,7 @@ Status game_actions_attack(Game *game)
   int random_num;
   int player_health, char_health, n_attackers = 0, damaged_index, i;
   Character *ally;
-  Id attackers_ids[MAX_CHARACTERS + 1];
+  Id *attackers_ids = NULL;
   Id *followers_ids = NULL;
   Command *last_cmd = NULL;
 
@@ -445,6 +471,13 @@ Status game_actions_attack(Game *game)
     return ERROR;
   }
 
+  /* Reserva de los atacantes: seguidores mas el propio jugador */
+  attackers_ids = (Id *)malloc((n_attackers + 1) * sizeof(Id));
+  if (!attackers_ids)
+  {
+    return ERROR;
+  }
+
   for (i = 0; i < n_attackers; i++)
   {
     attackers_ids[i] = followers_ids[i];
@@ -453,12 +486,12 @@ Status game_actions_attack(Game *game)
   attackers_ids[n_attackers] = player_get_id(game_get_player(game));
   n_attackers++;
 
-  random_num = rand() % 10;
+  random_num = game_get_random(game, 10);
 
   /* >4 haces daño al enemigo*/
   if (random_num <= 4)
   {
-    damaged_index = rand() % n_attackers;
+    damaged_index = game_get_random(game, n_attackers);
 
     if (attackers_ids[damaged_index] == player_get_id(player))
     {
@@ -476,20 +509,22 @@ Status game_actions_attack(Game *game)
       ally = game_get_character(game, attackers_ids[damaged_index]);
       if (!ally)
       {
+        free(attackers_ids);
         return ERROR;
       }
 
       char_health = character_get_health(ally);
       char_health--;
-      character_set_health(ally, char_health);
+      game_set_character_health(game, character_get_id(ally), char_health);
     }
   }
   else
   {
     char_health -= n_attackers;
-    character_set_health(enemy, char_health);
+    game_set_character_health(game, enemy_id, char_health);
   }
 
+  free(attackers_ids);
   return OK;
 }
 
@@ -725,7 +760,7 @@ Status game_actions_recruit(Game *game)
     return ERROR;
   }
 
-  if (character_set_following(character, player_get_id(game_get_player(game))) == ERROR)
+  if (game_set_character_following(game, character_get_id(character), player_get_id(game_get_player(game))) == ERROR)
   {
 
     return ERROR;
@@ -778,7 +813,7 @@ Status game_actions_abandon(Game *game)
 
     if (!strcasecmp(arg[0], character_get_name(character)))
     {
-      if (character_set_following(character, NO_ID) == ERROR)
+      if (game_set_character_following(game, id[i], NO_ID) == ERROR)
       {
         return ERROR;
       }
@@ -821,7 +856,7 @@ Status game_actions_use(Game *game)
   {
     return ERROR;
   }
-  if (!player_has_object(player, object_in_backpack))
+  if (game_player_has_object(game, object_in_backpack) == FALSE)
   {
     return ERROR;
   }
@@ -894,7 +929,7 @@ Status game_actions_open(Game *game)
   {
     return ERROR;
   }
-  if (!player_has_object(player, object_id))
+  if (game_player_has_object(game, object_id) == FALSE)
   {
     return ERROR;
   }
@@ -18,109 +18,64 @@
 #include "game_actions.h"
 #include <time.h>
 
-BOOL game_loop_command_allows_turn_roll(CommandCode code);
-void game_loop_update_turn(Game *game, Command *command);
+#define RECORD_SEED_FORMAT "#seed %lu"
 
-BOOL game_loop_command_allows_turn_roll(CommandCode code)
-{
-  switch (code)
-  {
-  case TAKE:
-  case DROP:
-  case MOVE:
-  case INSPECT:
-  case USE:
-  case OPEN:
-    return TRUE;
-  default:
-    return FALSE;
-  }
-}
+void game_loop_log_command(FILE *log_file, FILE *record_file, Game *game, Command *command);
+Status game_loop_read_seed(FILE *record_file, unsigned long *seed);
+int game_loop_run(Game *game, FILE *log_file, FILE *record_file);
+int game_loop_run_headless(Game *game, FILE *input, FILE *log_file, FILE *record_file);
+void game_loop_usage(char *program);
 
-void game_loop_update_turn(Game *game, Command *command)
+void game_loop_log_command(FILE *log_file, FILE *record_file, Game *game, Command *command)
 {
-  int random_num = 0;
-  char turn_message[WORD_SIZE] = "";
+  char *last_input = NULL;
 
-  if (!game || !command)
+  last_input = command_get_last_input(command);
+  if (!last_input)
   {
     return;
   }
+  last_input[strcspn(last_input, "\n")] = 0;
 
-  if (game_get_last_command_status(game) == ERROR)
+  /* Registro de la entrada y su resultado si hay log */
+  if (log_file)
   {
-    return;
+    fprintf(log_file, "%s: %s\n", last_input, game_get_last_command_status(game) == OK ? "OK" : "ERROR");
   }
 
-  if (game_loop_command_allows_turn_roll(command_get_code(command)) == FALSE)
+  /* Grabacion de la entrada tal cual para poder reproducir la partida */
+  if (record_file)
   {
-    return;
+    fprintf(record_file, "%s\n", last_input);
   }
+}
 
-  random_num = rand() % 10;
-  if (random_num <= 2)
-  {
-    game_next_turn(game);
-    sprintf(turn_message, "you rolled %d, next players turn", random_num);
-  }
-  else
+Status game_loop_read_seed(FILE *record_file, unsigned long *seed)
+{
+  char line[WORD_SIZE] = "";
+
+  /* La primera linea de una grabacion guarda la semilla */
+  if (!fgets(line, WORD_SIZE, record_file) || sscanf(line, RECORD_SEED_FORMAT, seed) != 1)
   {
-    sprintf(turn_message, "you rolled %d, you continue", random_num);
+    return ERROR;
   }
+  return OK;
+}
 
-  game_set_chat_message(game, turn_message);
+void game_loop_usage(char *program)
+{
+  fprintf(stderr, "Uso: %s <game_data_file> [-l <log_file>] [-b [<command_file>]] [-s <seed>] [-r <record_file>] [-p <record_file>]\n", program);
 }
 
-int main(int argc, char *argv[])
+int game_loop_run(Game *game, FILE *log_file, FILE *record_file)
 {
-  Game *game = NULL;
   Command *command = NULL;
   Graphic_engine *gengine;
-  FILE *log_file = NULL;
-  char *log_filename = NULL;
 
-  /* Inicializacion de la semilla aleatoria */
-  srand(time(NULL));
-printf("funciona");
-  /* Comprueba los argumentos de entrada */
-  if (argc < 2)
-  {
-    fprintf(stderr, "Uso: %s <game_data_file> [-l <log_file>]\n", argv[0]);
-    return 1;
-  }
-
-  /* Gestiona la apertura del archivo log si se solicita */
-  if (argc > 3 && strcmp(argv[2], "-l") == 0)
-  {
-    log_filename = argv[3];
-    log_file = fopen(log_filename, "w");
-    if (log_file == NULL)
-    {
-      fprintf(stderr, "Error opening log file.\n");
-      return 1;
-    }
-  }
-printf("se abre");
-  /* Inicializacion del juego desde archivo */
-  if (game_create_from_file(&game, argv[1]) == ERROR)
-  {
-    fprintf(stderr, "Error while initializing game.\n");
-    if (log_file)
-    {
-      fclose(log_file);
-    }
-    return 1;
-  }
-printf("se crea");
   /* Inicializacion del motor grafico */
   if ((gengine = graphic_engine_create()) == NULL)
   {
     fprintf(stderr, "Error while initializing graphic engine.\n");
-    game_destroy(game);
-    if (log_file)
-    {
-      fclose(log_file);
-    }
     return 1;
   }
 
@@ -138,16 +93,8 @@ printf("se crea");
     /* Procesa el comando y actualiza el estado */
     game_set_last_command_status(game, game_actions_update(game, command));
 
-    /* Registro en log si aplica */
-    if (log_file)
-    {
-      char *last_input = command_get_last_input(command);
-      if (last_input)
-      {
-        last_input[strcspn(last_input, "\n")] = 0;
-        fprintf(log_file, "%s: %s\n", last_input, game_get_last_command_status(game) == OK ? "OK" : "ERROR");
-      }
-    }
+    /* Registro en log y grabacion si aplica */
+    game_loop_log_command(log_file, record_file, game, command);
 
     if (command_get_code(command) == EXIT || game_get_finished(game)) break;
 
@@ -157,20 +104,177 @@ printf("se crea");
     sleep(1);
 
     /* Procesa el cambio de turno solo tras acciones validas de exploracion */
-    game_loop_update_turn(game, command);
+    game_actions_update_turn(game, command);
   }
 
   /* Imprime el estado final antes de salir */
   graphic_engine_paint_game(gengine, game, game_get_last_command_status(game), TRUE);
 
-  /* Liberacion de recursos generales */
-  game_destroy(game);
   graphic_engine_destroy(gengine);
+  return 0;
+}
+
+int game_loop_run_headless(Game *game, FILE *input, FILE *log_file, FILE *record_file)
+{
+  Command *command = NULL;
+  int next;
+
+  command = game_get_last_command(game);
+
+  /*
+   * Mismo bucle que el modo grafico sin pintar ni esperar: los comandos se
+   * leen del flujo hasta su final y solo se escribe el registro OK/ERROR.
+   * El fin del flujo termina el bucle sin registrar un exit que nadie pidio.
+   */
+  while ((command_get_code(command) != EXIT) && !game_get_finished(game))
+  {
+    if ((next = fgetc(input)) == EOF)
+    {
+      break;
+    }
+    ungetc(next, input);
+    command_get_input_from(command, input);
+
+    game_set_last_command_status(game, game_actions_update(game, command));
+
+    game_loop_log_command(log_file, record_file, game, command);
+
+    if (command_get_code(command) == EXIT || game_get_finished(game)) break;
+
+    game_actions_update_turn(game, command);
+  }
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  Game *game = NULL;
+  FILE *log_file = NULL, *input = NULL, *record_file = NULL;
+  char *log_filename = NULL, *input_filename = NULL, *record_filename = NULL, *replay_filename = NULL;
+  char *endptr = NULL;
+  BOOL headless = FALSE;
+  unsigned long seed;
+  int i, result = 1;
+
+  /* Semilla por defecto: la hora actual, como hasta ahora */
+  seed = (unsigned long)time(NULL);
+
+  /* Comprueba los argumentos de entrada */
+  if (argc < 2)
+  {
+    game_loop_usage(argv[0]);
+    return 1;
+  }
+
+  /* Opciones: log, modo por lotes, semilla, grabacion y reproduccion */
+  for (i = 2; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+    {
+      log_filename = argv[++i];
+    }
+    else if (strcmp(argv[i], "-b") == 0)
+    {
+      headless = TRUE;
+      if (i + 1 < argc && argv[i + 1][0] != '-')
+      {
+        input_filename = argv[++i];
+      }
+    }
+    else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+    {
+      seed = strtoul(argv[++i], &endptr, 10);
+      if (*endptr != '\0')
+      {
+        game_loop_usage(argv[0]);
+        return 1;
+      }
+    }
+    else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+    {
+      record_filename = argv[++i];
+    }
+    else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+    {
+      /* Reproduccion: por lotes, con la semilla y los comandos grabados */
+      replay_filename = argv[++i];
+      headless = TRUE;
+    }
+    else
+    {
+      game_loop_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  /* Apertura de la entrada: grabacion a reproducir, archivo de comandos o stdin */
+  input = stdin;
+  if (replay_filename || input_filename)
+  {
+    input = fopen(replay_filename ? replay_filename : input_filename, "r");
+    if (input == NULL)
+    {
+      fprintf(stderr, "Error opening command file.\n");
+      return 1;
+    }
+    if (replay_filename && game_loop_read_seed(input, &seed) == ERROR)
+    {
+      fprintf(stderr, "Error reading seed from record file.\n");
+      fclose(input);
+      return 1;
+    }
+  }
+
+  /* Gestiona la apertura del archivo log si se solicita */
+  if (log_filename && (log_file = fopen(log_filename, "w")) == NULL)
+  {
+    fprintf(stderr, "Error opening log file.\n");
+  }
+  /* La grabacion empieza por la semilla usada */
+  else if (record_filename && (record_file = fopen(record_filename, "w")) == NULL)
+  {
+    fprintf(stderr, "Error opening record file.\n");
+  }
+  /* Inicializacion del juego desde archivo */
+  else if (game_create_from_file(&game, argv[1]) == ERROR)
+  {
+    fprintf(stderr, "Error while initializing game.\n");
+  }
+  else
+  {
+    game_set_seed(game, seed);
+    if (record_file)
+    {
+      fprintf(record_file, RECORD_SEED_FORMAT "\n", seed);
+    }
+
+    if (headless)
+    {
+      /* Sin archivo de log el registro va a la salida estandar */
+      result = game_loop_run_headless(game, input, log_file ? log_file : stdout, record_file);
+    }
+    else
+    {
+      result = game_loop_run(game, log_file, record_file);
+    }
+
+    /* Liberacion de recursos generales */
+    game_destroy(game);
+  }
 
   if (log_file)
   {
     fclose(log_file);
   }
+  if (record_file)
+  {
+    fclose(record_file);
+  }
+  if (input != stdin)
+  {
+    fclose(input);
+  }
 
-  return 0;
+  return result;
 }
@@ -1,433 +1,1026 @@
+#define _POSIX_C_SOURCE 200112L
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "game.h"
+#include "game_managment.h"
 #include "space.h"
 #include "character.h"
 #include "object.h"
 #include "player.h"
 #include "link.h"
+#include "id_map.h"
 
-Status game_managment_load_spaces(Game *game, char *filename)
+#define INIT_PENDING 16
+#define MAX_FIELDS 10
+#define ALL_RECORDS '\0'
+#define INIT_STRINGS 1024
+#define WORLD_MAGIC "CWLD"
+#define WORLD_VERSION 2
+#define NO_INDEX -1
+#define NUMBER_SIZE 32
+
+/**
+ * @brief Field
+ * Campo de un registro de texto, sin copiar: apunta a la proyeccion del archivo.
+ */
+typedef struct
+{
+    const char *start; /*!< Primer caracter del campo */
+    int length;        /*!< Numero de caracteres del campo */
+} Field;
+
+/*
+ * Imagen compilada del mundo: cabecera, registros de anchura fija de cada
+ * tipo de entidad y, al final, la tabla de cadenas. Los textos se guardan
+ * como desplazamientos en la tabla, donde cada cadena distinta aparece una
+ * sola vez, y las referencias a espacios como su posicion en el vector de
+ * registros de espacios, ya resueltas por el compilador. La imagen usa el
+ * formato nativo de la maquina que la genera.
+ */
+typedef struct
+{
+    char magic[4];     /*!< Firma WORLD_MAGIC */
+    int version;       /*!< Version del formato */
+    int n_spaces;      /*!< Numero de registros de espacios */
+    int n_links;       /*!< Numero de registros de enlaces */
+    int n_players;     /*!< Numero de registros de jugadores */
+    int n_objects;     /*!< Numero de registros de objetos */
+    int n_characters;  /*!< Numero de registros de personajes */
+    int strings_size;  /*!< Bytes de la tabla de cadenas */
+} WorldHeader;
+
+typedef struct
+{
+    Id id;                 /*!< Identificador del espacio */
+    int name;              /*!< Desplazamiento del nombre */
+    int gdesc[GDESC_ROWS]; /*!< Desplazamiento de cada fila grafica */
+    int discovered;        /*!< Espacio inicial de algun jugador */
+} SpaceRecord;
+
+typedef struct
+{
+    Id id;           /*!< Identificador del enlace */
+    int name;        /*!< Desplazamiento del nombre */
+    int origin;      /*!< Posicion del espacio de origen */
+    int destination; /*!< Posicion del espacio de destino o NO_INDEX */
+    int direction;   /*!< Direccion del enlace */
+    int open;        /*!< Enlace abierto */
+} LinkRecord;
+
+typedef struct
+{
+    Id id;        /*!< Identificador del jugador */
+    int name;     /*!< Desplazamiento del nombre */
+    int gdesc;    /*!< Desplazamiento de la descripcion grafica */
+    int location; /*!< Posicion del espacio inicial o NO_INDEX */
+    int health;   /*!< Salud inicial */
+    int max_objs; /*!< Capacidad de la mochila */
+} PlayerRecord;
+
+typedef struct
+{
+    Id id;         /*!< Identificador del objeto */
+    int name;      /*!< Desplazamiento del nombre */
+    int desc;      /*!< Desplazamiento de la descripcion */
+    Id dependency; /*!< Objeto del que depende */
+    Id open;       /*!< Enlace que abre */
+    int location;  /*!< Posicion del espacio o NO_INDEX */
+    int health;    /*!< Salud que otorga */
+    int movable;   /*!< Objeto movible */
+} ObjectRecord;
+
+typedef struct
+{
+    Id id;        /*!< Identificador del personaje */
+    int name;     /*!< Desplazamiento del nombre */
+    int gdesc;    /*!< Desplazamiento de la descripcion grafica */
+    int message;  /*!< Desplazamiento del mensaje */
+    int location; /*!< Posicion del espacio o NO_INDEX */
+    int health;   /*!< Salud inicial */
+    int friendly; /*!< Personaje amistoso */
+} CharacterRecord;
+
+/*
+ * Tabla de cadenas en construccion durante la compilacion.
+ */
+typedef struct
+{
+    char *data;       /*!< Cadenas concatenadas terminadas en '\0' */
+    int size;         /*!< Bytes ocupados */
+    int capacity;     /*!< Bytes reservados */
+    IdMap *interned;  /*!< Resumen de cada cadena -> su desplazamiento */
+    BOOL error;       /*!< Fallo de reserva durante la construccion */
+} WorldStrings;
+
+Status game_managment_read_space(Game *game, Field *fields, int n_fields);
+Object *game_managment_read_object(Game *game, Field *fields, int n_fields, Id *location_id);
+Character *game_managment_read_character(Game *game, Field *fields, int n_fields, Id *location_id);
+Player *game_managment_read_player(Game *game, Field *fields, int n_fields);
+Status game_managment_read_link(Game *game, Field *fields, int n_fields);
+char *game_managment_field(Field *fields, int n_fields, int index, char *text);
+long game_managment_field_long(Field *fields, int n_fields, int index, long default_value);
+const char *game_managment_split_record(const char *record, const char *end, Field *fields, int *n_fields);
+Status game_managment_parse(Game *game, const char *data, long size, char type);
+Status game_managment_load_file(Game *game, char *filename, char type);
+Status game_managment_add_pending(Id **pending, int *n_pending, int *capacity, Id id, Id location_id);
+void game_managment_discover_start(Game *game, Player *player);
+char *game_managment_image_string(char *strings, long strings_size, long offset);
+Id game_managment_image_space(SpaceRecord *spaces, int n_spaces, int index);
+Status game_managment_load_image(Game *game, char *data, long size);
+int game_managment_add_string(WorldStrings *strings, const char *text);
+int game_managment_space_index(IdMap *index, Id space_id);
+
+char *game_managment_field(Field *fields, int n_fields, int index, char *text)
+{
+    int length = 0;
+
+    /*
+     * Copia el campo en text (de WORD_SIZE bytes) para pasarlo a un
+     * modificador, que guarda su propia copia. Los campos ausentes se
+     * tratan como cadenas vacias.
+     */
+    if (index >= 0 && index < n_fields)
+    {
+        length = (fields[index].length < WORD_SIZE) ? fields[index].length : WORD_SIZE - 1;
+        memcpy(text, fields[index].start, length);
+    }
+    text[length] = '\0';
+    return text;
+}
+
+long game_managment_field_long(Field *fields, int n_fields, int index, long default_value)
+{
+    char number[NUMBER_SIZE];
+
+    if (index < 0 || index >= n_fields || fields[index].length >= NUMBER_SIZE)
+    {
+        return default_value;
+    }
+    memcpy(number, fields[index].start, fields[index].length);
+    number[fields[index].length] = '\0';
+    return strtol(number, NULL, 10);
+}
+
+Status game_managment_read_space(Game *game, Field *fields, int n_fields)
 {
-    FILE *file = NULL;
-    char line[WORD_SIZE] = "";
-    char name[WORD_SIZE] = "";
-    char *toks = NULL;
-    Id id = NO_ID;
     Space *space = NULL;
-    Status status = OK;
-    char *endptr;
     char gdesc[GDESC_ROWS][GDESC_COLS];
+    char text[WORD_SIZE];
     int i;
     Status des;
 
-    /* Comprueba la validez del nombre de archivo */
-    if (!filename)
-    {
-        return ERROR;
-    }
-
-    file = fopen(filename, "r");
-    /* Comprueba si falla la apertura del archivo */
-    if (file == NULL)
+    if (n_fields < 2)
     {
         return ERROR;
     }
 
-    /* Lectura de espacios linea a linea */
-    while (fgets(line, WORD_SIZE, file))
+    /* Extraccion de la descripcion grafica bidimensional */
+    for (i = 0, des = OK; i < GDESC_ROWS; i++)
     {
-        if (strncmp("#s:", line, 3) == 0)
+        if (i + 2 < n_fields)
         {
-            toks = strtok(line + 3, "|");
-            id = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            strcpy(name, toks);
-
-            /* Extraccion de la descripcion grafica bidimensional */
-            for (i = 0, des = OK; i < GDESC_ROWS; i++)
+            if (fields[i + 2].length != GDESC_COLS - 1)
             {
-                toks = strtok(NULL, "|");
-                if (toks)
-                {
-                    if (strlen(toks) != GDESC_COLS - 1)
-                    {
-                        des = ERROR;
-                    }
-                    else
-                    {
-                        strcpy(gdesc[i], toks);
-                    }
-                }
-                else
-                {
-                    strcpy(gdesc[i], "         ");
-                }
+                des = ERROR;
             }
-
-            /* Creacion e integracion del espacio en el motor de juego */
-            space = space_create(id);
-            if (space != NULL)
+            else
             {
-                space_set_name(space, name);
-                if (des != ERROR)
-                {
-                    space_set_gdesc(space, gdesc);
-                }
-
-                game_add_space(game, space);
+                memcpy(gdesc[i], fields[i + 2].start, GDESC_COLS - 1);
+                gdesc[i][GDESC_COLS - 1] = '\0';
             }
         }
+        else
+        {
+            strcpy(gdesc[i], "         ");
+        }
     }
 
-    /* Verificacion de errores de lectura */
-    if (ferror(file))
+    /* Creacion e integracion del espacio en el motor de juego */
+    space = space_create_in(game_get_arena(game), game_managment_field_long(fields, n_fields, 0, NO_ID));
+    if (space == NULL)
     {
-        status = ERROR;
+        return ERROR;
+    }
+    space_set_name(space, game_managment_field(fields, n_fields, 1, text));
+    if (des != ERROR)
+    {
+        space_set_gdesc(space, gdesc);
     }
 
-    fclose(file);
-    return status;
+    return game_add_space(game, space);
 }
 
-Status game_managment_load_objects(Game *game, char *filename)
+Object *game_managment_read_object(Game *game, Field *fields, int n_fields, Id *location_id)
 {
-    FILE *file = NULL;
-    char line[WORD_SIZE] = "";
-    char name[WORD_SIZE] = "";
-    char *toks = NULL;
-    Id id = NO_ID, location_id = NO_ID;
-    Id dependency = NO_ID, open = NO_ID;
     Object *object = NULL;
-    Status status = OK;
-    char *endptr;
-    char description[WORD_SIZE] = "";
-    int health = 0;
-    int movable = 0;
+    char text[WORD_SIZE];
+
+    if (n_fields < 3)
+    {
+        return NULL;
+    }
+
+    /* Creacion e integracion del objeto en el motor de juego */
+    object = object_create_in(game_get_arena(game), game_managment_field_long(fields, n_fields, 0, NO_ID));
+    if (object != NULL)
+    {
+        *location_id = game_managment_field_long(fields, n_fields, 2, NO_ID);
+        object_set_name(object, game_managment_field(fields, n_fields, 1, text));
+        object_set_desc(object, game_managment_field(fields, n_fields, 3, text));
+        object_set_health(object, (int)game_managment_field_long(fields, n_fields, 4, 0));
+        object_set_movable(object, game_managment_field_long(fields, n_fields, 5, 0) ? TRUE : FALSE);
+        object_set_dependency(object, game_managment_field_long(fields, n_fields, 6, NO_ID));
+        object_set_open(object, game_managment_field_long(fields, n_fields, 7, NO_ID));
+
+        game_add_object(game, object);
+    }
+
+    return object;
+}
+
+Character *game_managment_read_character(Game *game, Field *fields, int n_fields, Id *location_id)
+{
+    Character *character = NULL;
+    char text[WORD_SIZE];
+
+    if (n_fields < 4)
+    {
+        return NULL;
+    }
 
-    /* Comprueba la validez del nombre de archivo */
-    if (!filename)
+    /* Creacion e integracion del personaje en el motor de juego */
+    character = character_create_in(game_get_arena(game), game_managment_field_long(fields, n_fields, 0, NO_ID));
+    if (character != NULL)
+    {
+        *location_id = game_managment_field_long(fields, n_fields, 3, NO_ID);
+        character_set_name(character, game_managment_field(fields, n_fields, 1, text));
+        character_set_gdesc(character, game_managment_field(fields, n_fields, 2, text));
+        character_set_health(character, (int)game_managment_field_long(fields, n_fields, 4, 0));
+        character_set_friendly(character, (int)game_managment_field_long(fields, n_fields, 5, 0));
+        character_set_message(character, game_managment_field(fields, n_fields, 6, text));
+
+        game_add_character(game, character);
+    }
+
+    return character;
+}
+
+Player *game_managment_read_player(Game *game, Field *fields, int n_fields)
+{
+    Player *player = NULL;
+    char text[WORD_SIZE];
+
+    if (n_fields < 4)
+    {
+        return NULL;
+    }
+
+    /* Creacion e integracion del jugador en el motor de juego */
+    player = player_create_in(game_get_arena(game), game_managment_field_long(fields, n_fields, 0, NO_ID));
+    if (player != NULL)
+    {
+        player_set_name(player, game_managment_field(fields, n_fields, 1, text));
+        player_set_gdesc(player, game_managment_field(fields, n_fields, 2, text));
+        player_set_location(player, game_managment_field_long(fields, n_fields, 3, NO_ID));
+        player_set_health(player, (int)game_managment_field_long(fields, n_fields, 4, 0));
+        inventory_set_max_objs(player_get_backpack(player), (int)game_managment_field_long(fields, n_fields, 5, 0));
+
+        game_set_player(game, player);
+    }
+
+    return player;
+}
+
+Status game_managment_read_link(Game *game, Field *fields, int n_fields)
+{
+    Link *link = NULL;
+    char text[WORD_SIZE];
+
+    if (n_fields < 5)
     {
         return ERROR;
     }
 
-    file = fopen(filename, "r");
-    /* Comprueba si falla la apertura del archivo */
-    if (file == NULL)
+    /* Creacion e integracion del enlace en el motor de juego */
+    link = link_create_in(game_get_arena(game), game_managment_field_long(fields, n_fields, 0, NO_ID));
+    if (link == NULL)
     {
         return ERROR;
     }
+    link_set_name(link, game_managment_field(fields, n_fields, 1, text));
+    link_set_origin(link, game_managment_field_long(fields, n_fields, 2, NO_ID));
+    link_set_destination(link, game_managment_field_long(fields, n_fields, 3, NO_ID));
+    link_set_direction(link, (Directions)game_managment_field_long(fields, n_fields, 4, NO_DIRECTION));
+    link_set_open(link, game_managment_field_long(fields, n_fields, 5, 0) ? TRUE : FALSE);
+
+    return game_add_link(game, link);
+}
+
+void game_managment_discover_start(Game *game, Player *player)
+{
+    Space *starting_space = NULL;
+
+    /* Asignacion del estado descubierto al espacio inicial */
+    starting_space = game_get_space(game, player_get_location(player));
+    if (starting_space != NULL)
+    {
+        space_set_discovered(starting_space, TRUE);
+    }
+}
+
+const char *game_managment_split_record(const char *record, const char *end, Field *fields, int *n_fields)
+{
+    const char *p = record, *start = NULL;
 
-    /* Lectura de objetos linea a linea */
-    while (fgets(line, WORD_SIZE, file))
+    /*
+     * Separa los campos de un registro sin escribir en el: cada campo es su
+     * inicio y su longitud hasta el siguiente '|' o el fin de linea. Como
+     * strtok, los campos vacios se omiten. Devuelve el inicio de la linea
+     * siguiente.
+     */
+    *n_fields = 0;
+    while (p < end && *p != '\n' && *p != '\r')
     {
-        if (strncmp("#o:", line, 3) == 0)
+        start = p;
+        while (p < end && *p != '|' && *p != '\n' && *p != '\r')
         {
-            toks = strtok(line + 3, "|");
-            id = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            strcpy(name, toks);
-            toks = strtok(NULL, "|");
-            location_id = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            if (toks)
-            {
-                strcpy(description, toks);
-            }
-            toks = strtok(NULL, "|");
-            if (toks)
-            {
-                health = (int)strtol(toks, &endptr, 10);
-            }
-            else
-            {
-                health = 0;
-            }
-            toks = strtok(NULL, "|");
-            if (toks)
-            {
-                movable = (int)strtol(toks, &endptr, 10);
-            }
-            else
-            {
-                movable = 0;
-            }
-            toks = strtok(NULL, "|");
-            if (toks)
-            {
-                dependency = strtol(toks, &endptr, 10);
-            }
-            else
-            {
-                dependency = NO_ID;
-            }
-            toks = strtok(NULL, "|");
-            if (toks)
-            {
-                open = strtol(toks, &endptr, 10);
-            }
-            else
-            {
-                open = NO_ID;
-            }
+            p++;
+        }
+        if (p > start && *n_fields < MAX_FIELDS)
+        {
+            fields[*n_fields].start = start;
+            fields[*n_fields].length = (int)(p - start);
+            (*n_fields)++;
+        }
+        if (p < end && *p == '|')
+        {
+            p++;
+        }
+    }
+
+    /* Avanza hasta la linea siguiente */
+    p = memchr(p, '\n', end - p);
+    return p ? p + 1 : end;
+}
+
+Status game_managment_add_pending(Id **pending, int *n_pending, int *capacity, Id id, Id location_id)
+{
+    Id *grown = NULL;
+    int new_capacity;
+
+    /* Duplica el buffer de pares (id, ubicacion) si esta lleno */
+    if (*n_pending >= *capacity)
+    {
+        new_capacity = (*capacity > 0) ? 2 * (*capacity) : INIT_PENDING;
+        grown = (Id *)realloc(*pending, 2 * new_capacity * sizeof(Id));
+        if (!grown)
+        {
+            return ERROR;
+        }
+        *pending = grown;
+        *capacity = new_capacity;
+    }
+
+    (*pending)[2 * (*n_pending)] = id;
+    (*pending)[2 * (*n_pending) + 1] = location_id;
+    (*n_pending)++;
+    return OK;
+}
 
-            /* Creacion e integracion del objeto en el motor de juego */
-            object = object_create(id);
+Status game_managment_parse(Game *game, const char *data, long size, char type)
+{
+    const char *p = data, *end = data + size, *next = NULL;
+    Field fields[MAX_FIELDS];
+    int n_fields = 0;
+    Status status = OK;
+    Object *object = NULL;
+    Character *character = NULL;
+    Player *player = NULL;
+    Id location_id = NO_ID;
+    Id *pending_objects = NULL, *pending_characters = NULL;
+    int n_pending_objects = 0, n_pending_characters = 0;
+    int objects_capacity = 0, characters_capacity = 0;
+    int i, n_players = game_get_number_of_players(game);
+
+    /*
+     * Una sola pasada: cada registro se crea segun su prefijo y las
+     * ubicaciones de objetos y personajes se aplazan hasta que todos los
+     * espacios esten cargados.
+     */
+    while (status == OK && p < end)
+    {
+        /* Registros que no son del tipo pedido: salto directo a la siguiente linea */
+        if (end - p < 3 || p[0] != '#' || p[2] != ':' || (type != ALL_RECORDS && p[1] != type))
+        {
+            next = memchr(p, '\n', end - p);
+            p = next ? next + 1 : end;
+            continue;
+        }
+
+        next = game_managment_split_record(p + 3, end, fields, &n_fields);
+
+        switch (p[1])
+        {
+        case 's':
+            game_managment_read_space(game, fields, n_fields);
+            break;
+        case 'o':
+            object = game_managment_read_object(game, fields, n_fields, &location_id);
             if (object != NULL)
             {
-                object_set_name(object, name);
-                object_set_desc(object, description);
-                object_set_health(object, health);
-                object_set_movable(object, movable ? TRUE : FALSE);
-                object_set_dependency(object, dependency);
-                object_set_open(object, open);
-
-                game_add_object(game, object);
-                game_set_object_location(game, location_id, id);
+                status = game_managment_add_pending(&pending_objects, &n_pending_objects, &objects_capacity, object_get_id(object), location_id);
             }
+            break;
+        case 'c':
+            character = game_managment_read_character(game, fields, n_fields, &location_id);
+            if (character != NULL)
+            {
+                status = game_managment_add_pending(&pending_characters, &n_pending_characters, &characters_capacity, character_get_id(character), location_id);
+            }
+            break;
+        case 'p':
+            game_managment_read_player(game, fields, n_fields);
+            break;
+        case 'l':
+            game_managment_read_link(game, fields, n_fields);
+            break;
+        default:
+            break;
         }
+        p = next;
     }
 
-    /* Verificacion de errores de lectura */
-    if (ferror(file))
+    /* Resolucion de las dependencias de ubicacion tras la pasada */
+    if (status == OK)
     {
-        status = ERROR;
+        for (i = n_players; i < game_get_number_of_players(game); i++)
+        {
+            player = game_get_player_from_index(game, i);
+            game_managment_discover_start(game, player);
+        }
+        for (i = 0; i < n_pending_objects; i++)
+        {
+            game_set_object_location(game, pending_objects[2 * i + 1], pending_objects[2 * i]);
+        }
+        for (i = 0; i < n_pending_characters; i++)
+        {
+            game_set_character_location(game, pending_characters[2 * i + 1], pending_characters[2 * i]);
+        }
     }
 
-    fclose(file);
+    free(pending_objects);
+    free(pending_characters);
     return status;
 }
 
-Status game_managment_load_characters(Game *game, char *filename)
+Status game_managment_load_file(Game *game, char *filename, char type)
 {
-    FILE *file = NULL;
-    char line[WORD_SIZE] = "";
-    char name[WORD_SIZE] = "";
-    char gdesc[7] = "";
-    char message[101] = "";
-    char *toks = NULL;
-    Id id = NO_ID, location_id = NO_ID;
-    int health = 0;
-    int friendly = 0;
-    Character *character = NULL;
-    Status status = OK;
-    char *endptr;
+    int fd;
+    struct stat info;
+    char *data = NULL;
+    Status status;
 
-    /* Comprueba la validez del nombre de archivo */
-    if (!filename)
+    /* Comprueba la validez de los parametros */
+    if (!game || !filename)
     {
         return ERROR;
     }
 
-    file = fopen(filename, "r");
+    fd = open(filename, O_RDONLY);
     /* Comprueba si falla la apertura del archivo */
-    if (file == NULL)
+    if (fd < 0)
     {
         return ERROR;
     }
+    if (fstat(fd, &info) < 0)
+    {
+        close(fd);
+        return ERROR;
+    }
 
-    /* Lectura de personajes linea a linea */
-    while (fgets(line, WORD_SIZE, file))
-    {
-        if (strncmp("#c:", line, 3) == 0)
-        {
-            toks = strtok(line + 3, "|");
-            id = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            strcpy(name, toks);
-            toks = strtok(NULL, "|");
-            strcpy(gdesc, toks);
-            toks = strtok(NULL, "|");
-            location_id = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            health = (int)strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            friendly = (int)strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            strcpy(message, toks);
-
-            /* Creacion e integracion del personaje en el motor de juego */
-            character = character_create(id);
-            if (character != NULL)
-            {
-                character_set_name(character, name);
-                character_set_gdesc(character, gdesc);
-                character_set_health(character, health);
-                character_set_friendly(character, friendly);
-                character_set_message(character, message);
-
-                game_add_character(game, character);
-                game_set_character_location(game, location_id, id);
-            }
-        }
+    /* Un archivo vacio no tiene registros */
+    if (info.st_size == 0)
+    {
+        close(fd);
+        return OK;
     }
 
-    /* Verificacion de errores de lectura */
-    if (ferror(file))
+    /*
+     * Proyeccion de solo lectura: los campos se leen en el sitio como
+     * tramos del mapa y solo se copian al pasarlos a las entidades, asi que
+     * ninguna pagina del archivo llega a duplicarse.
+     */
+    data = (char *)mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
     {
-        status = ERROR;
+        return ERROR;
     }
 
-    fclose(file);
+    /* Las imagenes compiladas solo se cargan completas */
+    if (info.st_size >= (long)sizeof(WorldHeader) && memcmp(data, WORLD_MAGIC, 4) == 0)
+    {
+        status = (type == ALL_RECORDS) ? game_managment_load_image(game, data, (long)info.st_size) : ERROR;
+    }
+    else
+    {
+        status = game_managment_parse(game, data, (long)info.st_size, type);
+    }
+
+    munmap(data, info.st_size);
     return status;
 }
 
+Status game_managment_load_game(Game *game, char *filename)
+{
+    return game_managment_load_file(game, filename, ALL_RECORDS);
+}
+
+Status game_managment_load_spaces(Game *game, char *filename)
+{
+    return game_managment_load_file(game, filename, 's');
+}
+
+Status game_managment_load_objects(Game *game, char *filename)
+{
+    return game_managment_load_file(game, filename, 'o');
+}
+
+Status game_managment_load_characters(Game *game, char *filename)
+{
+    return game_managment_load_file(game, filename, 'c');
+}
+
 Status game_managment_load_players(Game *game, char *filename)
 {
-    FILE *file = NULL;
-    char line[WORD_SIZE] = "";
-    char name[WORD_SIZE] = "";
-    char gdesc[WORD_SIZE] = "";
-    char *toks = NULL;
-    Id id = NO_ID, location_id = NO_ID;
-    int health = 0, max_objs = 0;
+    return game_managment_load_file(game, filename, 'p');
+}
+
+Status game_managment_load_links(Game *game, char *filename)
+{
+    return game_managment_load_file(game, filename, 'l');
+}
+
+char *game_managment_image_string(char *strings, long strings_size, long offset)
+{
+    /* Los desplazamientos fuera de la tabla se tratan como cadenas vacias */
+    if (offset < 0 || offset >= strings_size)
+    {
+        return "";
+    }
+    return strings + offset;
+}
+
+Id game_managment_image_space(SpaceRecord *spaces, int n_spaces, int index)
+{
+    /* Traduce la posicion precalculada al Id del espacio */
+    if (index < 0 || index >= n_spaces)
+    {
+        return NO_ID;
+    }
+    return spaces[index].id;
+}
+
+Status game_managment_load_image(Game *game, char *data, long size)
+{
+    WorldHeader *header = (WorldHeader *)data;
+    SpaceRecord *spaces = NULL;
+    LinkRecord *links = NULL;
+    PlayerRecord *players = NULL;
+    ObjectRecord *objects = NULL;
+    CharacterRecord *characters = NULL;
+    char *strings = NULL;
+    char gdesc[GDESC_ROWS][GDESC_COLS];
+    Space *space = NULL;
+    Link *link = NULL;
     Player *player = NULL;
-    Status status = OK;
-    char *endptr;
-    Space *starting_space = NULL;
+    Object *object = NULL;
+    Character *character = NULL;
+    long expected;
+    int i, j, first_space, first_object, first_character;
 
-    /* Comprueba la validez del nombre de archivo */
-    if (!filename)
+    /* Comprueba que la cabecera describe exactamente el archivo */
+    if (header->version != WORLD_VERSION || header->n_spaces < 0 || header->n_links < 0 || header->n_players < 0 || header->n_objects < 0 || header->n_characters < 0 || header->strings_size <= 0)
+    {
+        return ERROR;
+    }
+    expected = (long)sizeof(WorldHeader) + header->n_spaces * (long)sizeof(SpaceRecord) + header->n_links * (long)sizeof(LinkRecord) + header->n_players * (long)sizeof(PlayerRecord) + header->n_objects * (long)sizeof(ObjectRecord) + header->n_characters * (long)sizeof(CharacterRecord) + header->strings_size;
+    if (expected != size)
     {
         return ERROR;
     }
 
-    file = fopen(filename, "r");
-    /* Comprueba si falla la apertura del archivo */
-    if (file == NULL)
+    /* Las secciones se leen directamente de la proyeccion del archivo */
+    spaces = (SpaceRecord *)(data + sizeof(WorldHeader));
+    links = (LinkRecord *)(spaces + header->n_spaces);
+    players = (PlayerRecord *)(links + header->n_links);
+    objects = (ObjectRecord *)(players + header->n_players);
+    characters = (CharacterRecord *)(objects + header->n_objects);
+    strings = (char *)(characters + header->n_characters);
+    if (strings[header->strings_size - 1] != '\0')
     {
         return ERROR;
     }
 
-    /* Lectura de jugadores linea a linea */
-    while (fgets(line, WORD_SIZE, file))
+    /*
+     * Las posiciones de la imagen son posiciones en los vectores del juego,
+     * desplazadas por lo que ya hubiera cargado: enlaces y ubicaciones se
+     * colocan directamente, sin buscar ningun Id.
+     */
+    first_space = game_get_number_of_space(game);
+    first_object = game_get_number_of_objects(game);
+    first_character = game_get_number_of_characters(game);
+
+    for (i = 0; i < header->n_spaces; i++)
     {
-        if (strncmp("#p:", line, 3) == 0)
+        space = space_create_in(game_get_arena(game), spaces[i].id);
+        if (space == NULL)
+        {
+            return ERROR;
+        }
+        space_set_name(space, game_managment_image_string(strings, header->strings_size, spaces[i].name));
+        for (j = 0; j < GDESC_ROWS; j++)
+        {
+            strncpy(gdesc[j], game_managment_image_string(strings, header->strings_size, spaces[i].gdesc[j]), GDESC_COLS - 1);
+            gdesc[j][GDESC_COLS - 1] = '\0';
+        }
+        space_set_gdesc(space, gdesc);
+        space_set_discovered(space, spaces[i].discovered ? TRUE : FALSE);
+        if (game_add_space(game, space) == ERROR)
         {
-            toks = strtok(line + 3, "|");
-            id = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            strcpy(name, toks);
-            toks = strtok(NULL, "|");
-            strcpy(gdesc, toks);
-            toks = strtok(NULL, "|");
-            location_id = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            health = (int)strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            max_objs = (int)strtol(toks, &endptr, 10);
+            space_destroy(space);
+            return ERROR;
+        }
+    }
 
-            /* Creacion e integracion del jugador en el motor de juego */
-            player = player_create(id);
-            if (player != NULL)
-            {
-                player_set_name(player, name);
-                player_set_gdesc(player, gdesc);
-                player_set_location(player, location_id);
-                player_set_health(player, health);
-                inventory_set_max_objs(player_get_backpack(player), max_objs);
-
-                game_set_player(game, player);
-
-                /* Asignacion del estado descubierto al espacio inicial */
-                starting_space = game_get_space(game, location_id);
-                if (starting_space != NULL)
-                {
-                    space_set_discovered(starting_space, TRUE);
-                }
-            }
+    for (i = 0; i < header->n_links; i++)
+    {
+        link = link_create_in(game_get_arena(game), links[i].id);
+        if (link == NULL)
+        {
+            return ERROR;
+        }
+        link_set_name(link, game_managment_image_string(strings, header->strings_size, links[i].name));
+        link_set_origin(link, game_managment_image_space(spaces, header->n_spaces, links[i].origin));
+        link_set_destination(link, game_managment_image_space(spaces, header->n_spaces, links[i].destination));
+        link_set_direction(link, (Directions)links[i].direction);
+        link_set_open(link, links[i].open ? TRUE : FALSE);
+        if (links[i].origin < 0 || links[i].origin >= header->n_spaces || game_add_link_at(game, link, first_space + links[i].origin) == ERROR)
+        {
+            link_destroy(link);
+            return ERROR;
         }
     }
 
-    /* Verificacion de errores de lectura */
-    if (ferror(file))
+    for (i = 0; i < header->n_players; i++)
     {
-        status = ERROR;
+        player = player_create_in(game_get_arena(game), players[i].id);
+        if (player == NULL)
+        {
+            return ERROR;
+        }
+        player_set_name(player, game_managment_image_string(strings, header->strings_size, players[i].name));
+        player_set_gdesc(player, game_managment_image_string(strings, header->strings_size, players[i].gdesc));
+        player_set_location(player, game_managment_image_space(spaces, header->n_spaces, players[i].location));
+        player_set_health(player, players[i].health);
+        inventory_set_max_objs(player_get_backpack(player), players[i].max_objs);
+        if (game_set_player(game, player) == ERROR)
+        {
+            player_destroy(player);
+            return ERROR;
+        }
     }
 
-    fclose(file);
-    return status;
+    for (i = 0; i < header->n_objects; i++)
+    {
+        object = object_create_in(game_get_arena(game), objects[i].id);
+        if (object == NULL)
+        {
+            return ERROR;
+        }
+        object_set_name(object, game_managment_image_string(strings, header->strings_size, objects[i].name));
+        object_set_desc(object, game_managment_image_string(strings, header->strings_size, objects[i].desc));
+        object_set_health(object, objects[i].health);
+        object_set_movable(object, objects[i].movable ? TRUE : FALSE);
+        object_set_dependency(object, objects[i].dependency);
+        object_set_open(object, objects[i].open);
+        if (game_add_object(game, object) == ERROR)
+        {
+            object_destroy(object);
+            return ERROR;
+        }
+        if (objects[i].location >= 0 && objects[i].location < header->n_spaces)
+        {
+            game_set_object_location_at(game, first_object + i, first_space + objects[i].location);
+        }
+    }
+
+    for (i = 0; i < header->n_characters; i++)
+    {
+        character = character_create_in(game_get_arena(game), characters[i].id);
+        if (character == NULL)
+        {
+            return ERROR;
+        }
+        character_set_name(character, game_managment_image_string(strings, header->strings_size, characters[i].name));
+        character_set_gdesc(character, game_managment_image_string(strings, header->strings_size, characters[i].gdesc));
+        character_set_message(character, game_managment_image_string(strings, header->strings_size, characters[i].message));
+        character_set_health(character, characters[i].health);
+        character_set_friendly(character, characters[i].friendly);
+        if (game_add_character(game, character) == ERROR)
+        {
+            character_destroy(character);
+            return ERROR;
+        }
+        if (characters[i].location >= 0 && characters[i].location < header->n_spaces)
+        {
+            game_set_character_location_at(game, first_character + i, first_space + characters[i].location);
+        }
+    }
+
+    return OK;
 }
 
-Status game_managment_load_links(Game *game, char *filename)
+int game_managment_add_string(WorldStrings *strings, const char *text)
 {
+    const unsigned char *c = NULL;
+    char *grown = NULL;
+    unsigned long hash = 5381;
+    int offset, length, new_capacity;
+
+    if (strings->error == TRUE)
+    {
+        return 0;
+    }
+    if (text == NULL)
+    {
+        text = "";
+    }
+
+    /*
+     * Busca la cadena por su resumen (djb2, como clave no negativa del
+     * IdMap). Dos cadenas distintas con el mismo resumen prueban la clave
+     * siguiente, asi que cada texto repetido devuelve el desplazamiento del
+     * primero.
+     */
+    for (c = (const unsigned char *)text; *c != '\0'; c++)
+    {
+        hash = hash * 33 + *c;
+    }
+    for (hash &= 0x7fffffffUL; (offset = id_map_get(strings->interned, (Id)hash)) != ID_MAP_NOT_FOUND; hash = (hash + 1) & 0x7fffffffUL)
+    {
+        if (strcmp(strings->data + offset, text) == 0)
+        {
+            return offset;
+        }
+    }
+
+    /* Duplica la tabla hasta que quepa la cadena con su terminador */
+    length = (int)strlen(text) + 1;
+    if (strings->size + length > strings->capacity)
+    {
+        new_capacity = (strings->capacity > 0) ? strings->capacity : INIT_STRINGS;
+        while (strings->size + length > new_capacity)
+        {
+            new_capacity *= 2;
+        }
+        grown = (char *)realloc(strings->data, new_capacity);
+        if (!grown)
+        {
+            strings->error = TRUE;
+            return 0;
+        }
+        strings->data = grown;
+        strings->capacity = new_capacity;
+    }
+
+    if (id_map_put(strings->interned, (Id)hash, strings->size) == ERROR)
+    {
+        strings->error = TRUE;
+        return 0;
+    }
+    offset = strings->size;
+    memcpy(strings->data + offset, text, length);
+    strings->size += length;
+    return offset;
+}
+
+int game_managment_space_index(IdMap *index, Id space_id)
+{
+    int position = id_map_get(index, space_id);
+
+    return (position == ID_MAP_NOT_FOUND) ? NO_INDEX : position;
+}
+
+Status game_managment_compile_world(Game *game, char *filename)
+{
+    WorldHeader header;
+    WorldStrings strings;
+    SpaceRecord *spaces = NULL;
+    LinkRecord *links = NULL;
+    PlayerRecord *players = NULL;
+    ObjectRecord *objects = NULL;
+    CharacterRecord *characters = NULL;
+    IdMap *index = NULL;
     FILE *file = NULL;
-    char line[WORD_SIZE] = "";
-    char name[WORD_SIZE] = "";
-    char *toks = NULL;
-    Id id = NO_ID, origin = NO_ID, destination = NO_ID;
-    int dir_int = 0, open_int = 0;
+    Space *space = NULL;
     Link *link = NULL;
+    Player *player = NULL;
+    Object *object = NULL;
+    Character *character = NULL;
+    char (*gdesc)[GDESC_COLS];
     Status status = OK;
-    char *endptr;
+    int i, j;
 
-    /* Comprueba la validez del nombre de archivo */
-    if (!filename)
+    /* Comprueba la validez de los parametros */
+    if (!game || !filename)
     {
         return ERROR;
     }
 
-    file = fopen(filename, "r");
-    /* Comprueba si falla la apertura del archivo */
-    if (file == NULL)
+    memset(&header, 0, sizeof(WorldHeader));
+    memcpy(header.magic, WORLD_MAGIC, 4);
+    header.version = WORLD_VERSION;
+    header.n_spaces = game_get_number_of_space(game);
+    header.n_players = game_get_number_of_players(game);
+    header.n_objects = game_get_number_of_objects(game);
+    header.n_characters = game_get_number_of_characters(game);
+    strings.data = NULL;
+    strings.size = 0;
+    strings.capacity = 0;
+    strings.interned = id_map_create(0);
+    strings.error = (strings.interned == NULL) ? TRUE : FALSE;
+
+    /* Un enlace como maximo por direccion y espacio */
+    index = id_map_create(header.n_spaces);
+    spaces = (SpaceRecord *)calloc(header.n_spaces + 1, sizeof(SpaceRecord));
+    links = (LinkRecord *)calloc(header.n_spaces * N_DIRECTIONS + 1, sizeof(LinkRecord));
+    players = (PlayerRecord *)calloc(header.n_players + 1, sizeof(PlayerRecord));
+    objects = (ObjectRecord *)calloc(header.n_objects + 1, sizeof(ObjectRecord));
+    characters = (CharacterRecord *)calloc(header.n_characters + 1, sizeof(CharacterRecord));
+    if (!index || !spaces || !links || !players || !objects || !characters)
     {
-        return ERROR;
+        status = ERROR;
     }
 
-    /* Lectura de enlaces linea a linea */
-    while (fgets(line, WORD_SIZE, file))
+    /* La cadena vacia ocupa el desplazamiento 0 */
+    game_managment_add_string(&strings, "");
+
+    /* Espacios y tabla Id -> posicion; ante Ids repetidos prevalece el primero */
+    for (i = 0; status == OK && i < header.n_spaces; i++)
     {
-        if (strncmp("#l:", line, 3) == 0)
+        space = game_get_space_from_index(game, i);
+        spaces[i].id = space_get_id(space);
+        spaces[i].name = game_managment_add_string(&strings, space_get_name(space));
+        gdesc = space_get_gdesc(space);
+        for (j = 0; j < GDESC_ROWS; j++)
         {
-            toks = strtok(line + 3, "|");
-            id = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            strcpy(name, toks);
-            toks = strtok(NULL, "|");
-            origin = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            destination = strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            dir_int = (int)strtol(toks, &endptr, 10);
-            toks = strtok(NULL, "|");
-            open_int = (int)strtol(toks, &endptr, 10);
+            spaces[i].gdesc[j] = game_managment_add_string(&strings, gdesc ? gdesc[j] : "");
+        }
+        spaces[i].discovered = (space_get_discovered(space) == TRUE);
+        if (game_managment_space_index(index, spaces[i].id) == NO_INDEX)
+        {
+            status = id_map_put(index, spaces[i].id, i);
+        }
+    }
 
-            /* Creacion e integracion del enlace en el motor de juego */
-            link = link_create(id);
+    /*
+     * La imagen solo guarda los enlaces de la tabla de adyacencia, con sus
+     * espacios resueltos. Un enlace que no entro en ella desapareceria al
+     * compilar: se rechaza el mundo nombrando el enlace.
+     */
+    for (i = 0; status == OK && i < game_get_number_of_links(game); i++)
+    {
+        link = game_get_link_from_index(game, i);
+        space = game_get_space(game, link_get_origin(link));
+        if (space == NULL || game_managment_space_index(index, link_get_destination(link)) == NO_INDEX)
+        {
+            fprintf(stderr, "Link %ld: origin %ld or destination %ld is not a space.\n", link_get_id(link), link_get_origin(link), link_get_destination(link));
+            status = ERROR;
+        }
+        else if (link_get_direction(link) < 0 || link_get_direction(link) >= N_DIRECTIONS)
+        {
+            fprintf(stderr, "Link %ld: direction %d is not valid.\n", link_get_id(link), (int)link_get_direction(link));
+            status = ERROR;
+        }
+        else if (space_get_link_at(space, link_get_direction(link)) != link)
+        {
+            fprintf(stderr, "Link %ld: space %ld already has link %ld in direction %d.\n", link_get_id(link), space_get_id(space), link_get_id(space_get_link_at(space, link_get_direction(link))), (int)link_get_direction(link));
+            status = ERROR;
+        }
+    }
+
+    /* Enlaces agrupados por origen: todos estan en la tabla de adyacencia */
+    for (i = 0; status == OK && i < header.n_spaces; i++)
+    {
+        space = game_get_space_from_index(game, i);
+        for (j = 0; j < N_DIRECTIONS; j++)
+        {
+            link = space_get_link_at(space, (Directions)j);
             if (link != NULL)
             {
-                link_set_name(link, name);
-                link_set_origin(link, origin);
-                link_set_destination(link, destination);
-                link_set_direction(link, (Directions)dir_int);
-                link_set_open(link, open_int ? TRUE : FALSE);
-
-                game_add_link(game, link);
+                links[header.n_links].id = link_get_id(link);
+                links[header.n_links].name = game_managment_add_string(&strings, link_get_name(link));
+                links[header.n_links].origin = i;
+                links[header.n_links].destination = game_managment_space_index(index, link_get_destination(link));
+                links[header.n_links].direction = j;
+                links[header.n_links].open = (link_get_open(link) == TRUE);
+                header.n_links++;
             }
         }
     }
 
-    /* Verificacion de errores de lectura */
-    if (ferror(file))
+    for (i = 0; status == OK && i < header.n_players; i++)
+    {
+        player = game_get_player_from_index(game, i);
+        players[i].id = player_get_id(player);
+        players[i].name = game_managment_add_string(&strings, player_get_name(player));
+        players[i].gdesc = game_managment_add_string(&strings, player_get_gdesc(player));
+        players[i].location = game_managment_space_index(index, player_get_location(player));
+        players[i].health = player_get_health(player);
+        players[i].max_objs = inventory_get_max_objs(player_get_backpack(player));
+    }
+
+    for (i = 0; status == OK && i < header.n_objects; i++)
+    {
+        object = game_get_object_from_index(game, i);
+        objects[i].id = object_get_id(object);
+        objects[i].name = game_managment_add_string(&strings, object_get_name(object));
+        objects[i].desc = game_managment_add_string(&strings, object_get_desc(object));
+        objects[i].dependency = object_get_dependency(object);
+        objects[i].open = object_get_open(object);
+        objects[i].location = game_managment_space_index(index, game_get_object_location(game, objects[i].id));
+        objects[i].health = object_get_health(object);
+        objects[i].movable = (object_get_movable(object) == TRUE);
+    }
+
+    for (i = 0; status == OK && i < header.n_characters; i++)
+    {
+        character = game_get_character_from_index(game, i);
+        characters[i].id = character_get_id(character);
+        characters[i].name = game_managment_add_string(&strings, character_get_name(character));
+        characters[i].gdesc = game_managment_add_string(&strings, character_get_gdesc(character));
+        characters[i].message = game_managment_add_string(&strings, character_get_message(character));
+        characters[i].location = game_managment_space_index(index, game_get_character_location(game, characters[i].id));
+        characters[i].health = character_get_health(character);
+        characters[i].friendly = character_get_friendly(character);
+    }
+
+    /* Escritura de la imagen en un unico archivo binario */
+    if (status == OK && strings.error == FALSE)
+    {
+        header.strings_size = strings.size;
+        file = fopen(filename, "wb");
+        if (file == NULL
+            || fwrite(&header, sizeof(WorldHeader), 1, file) != 1
+            || fwrite(spaces, sizeof(SpaceRecord), header.n_spaces, file) != (size_t)header.n_spaces
+            || fwrite(links, sizeof(LinkRecord), header.n_links, file) != (size_t)header.n_links
+            || fwrite(players, sizeof(PlayerRecord), header.n_players, file) != (size_t)header.n_players
+            || fwrite(objects, sizeof(ObjectRecord), header.n_objects, file) != (size_t)header.n_objects
+            || fwrite(characters, sizeof(CharacterRecord), header.n_characters, file) != (size_t)header.n_characters
+            || fwrite(strings.data, 1, strings.size, file) != (size_t)strings.size)
+        {
+            status = ERROR;
+        }
+        if (file != NULL && fclose(file) != 0)
+        {
+            status = ERROR;
+        }
+    }
+    else
     {
         status = ERROR;
     }
 
-    fclose(file);
+    id_map_destroy(index);
+    free(spaces);
+    free(links);
+    free(players);
+    free(objects);
+    free(characters);
+    id_map_destroy(strings.interned);
+    free(strings.data);
     return status;
 }
-Status game_managment_save_game(Game *game, char *filename){
-     FILE *file = NULL;
-    int i,l;
-    Player*p;
-    Character*c;
-    Object*o;
-    Space*s;
-    Link *e;
-    /* Comprueba la validez del nombre de archivo */
-    if (!filename||!game)
+
+Status game_managment_save_game(Game *game, char *filename)
+{
+    FILE *file = NULL;
+    int i;
+    Player *p = NULL;
+    Character *c = NULL;
+    Object *o = NULL;
+    Space *s = NULL;
+    Link *e = NULL;
+
+    /* Comprueba la validez de los parametros */
+    if (!filename || !game)
     {
         return ERROR;
     }
@@ -438,41 +1031,38 @@ Status game_managment_save_game(Game *game, char *filename){
     {
         return ERROR;
     }
-    if(game_get_number_of_players(game)<0){
-        return ERROR;
-    }
-    for(i=0;i<game_get_number_of_players(game);i++){
-        p=game_get_player_from_index(game,i);
-        fprintf(file, "#p:%d|%s|%s|%d|%d|%d|\n", player_get_id(p),player_get_name(p),player_get_gdesc(p),player_get_location(p),player_get_health(p),player_get_number_of_backpack(p));
+
+    /* Cada registro usa los campos que leen los game_managment_read_* */
+    for (i = 0; i < game_get_number_of_space(game); i++)
+    {
+        s = game_get_space_from_index(game, i);
+        fprintf(file, "#s:%ld|%s|%s|%s|%s|%s|%s|%d|\n", space_get_id(s), space_get_name(s), space_get_gdes_from_index(s, 0), space_get_gdes_from_index(s, 1), space_get_gdes_from_index(s, 2), space_get_gdes_from_index(s, 3), space_get_gdes_from_index(s, 4), space_get_discovered(s));
     }
-    if(game_get_number_of_characters(game)<0){
-        return ERROR;
+    for (i = 0; i < game_get_number_of_objects(game); i++)
+    {
+        o = game_get_object_from_index(game, i);
+        fprintf(file, "#o:%ld|%s|%ld|%s|%d|%d|%ld|%ld|\n", object_get_id(o), object_get_name(o), game_get_object_location(game, object_get_id(o)), object_get_desc(o), object_get_health(o), object_get_movable(o), object_get_dependency(o), object_get_open(o));
     }
-    for(i=0;i<game_get_number_of_characters(game);i++){
-        c=game_get_character_from_index(game,i);
-        fprintf(file, "#c:%d|%s|%s|%d|%d|%d|%s|%d|\n", character_get_id(c),character_get_name(c),character_get_gdesc(c),game_get_character_location(game,character_get_id(c)),character_get_id(c),character_get_friendly(c),character_get_message(c),character_get_following(c));
+    for (i = 0; i < game_get_number_of_players(game); i++)
+    {
+        p = game_get_player_from_index(game, i);
+        fprintf(file, "#p:%ld|%s|%s|%ld|%d|%d|\n", player_get_id(p), player_get_name(p), player_get_gdesc(p), player_get_location(p), player_get_health(p), inventory_get_max_objs(player_get_backpack(p)));
     }
-    if(game_get_number_of_objects(game)<0){
-        return ERROR;
+    for (i = 0; i < game_get_number_of_characters(game); i++)
+    {
+        c = game_get_character_from_index(game, i);
+        fprintf(file, "#c:%ld|%s|%s|%ld|%d|%d|%s|%ld|\n", character_get_id(c), character_get_name(c), character_get_gdesc(c), game_get_character_location(game, character_get_id(c)), character_get_health(c), character_get_friendly(c), character_get_message(c), character_get_following(c));
     }
-    for(i=0;i<game_get_number_of_objects(game);i++){
-        o=game_get_object_from_index(game,i);
-        fprintf(file, "#o:%d|%s|%d|%s|%d|%d|%d|%d|\n", object_get_id(o),object_get_name(o),game_get_object_location(game,object_get_id(o)),game_get_character_location(game,object_get_id(o)),object_get_desc(o),object_get_health(o),object_get_movable(o),object_get_dependency(o),object_get_open(o));
+    for (i = 0; i < game_get_number_of_links(game); i++)
+    {
+        e = game_get_link_from_index(game, i);
+        fprintf(file, "#l:%ld|%s|%ld|%ld|%d|%d|\n", link_get_id(e), link_get_name(e), link_get_origin(e), link_get_destination(e), link_get_direction(e), link_get_open(e));
     }
-    if(game_get_number_of_space(game)<0){
+
+    /* Comprueba que se hayan escrito todos los registros */
+    if (fclose(file) == EOF)
+    {
         return ERROR;
     }
-    for(i=0;i<game_get_number_of_space(game);i++){
-        s=game_get_space_from_index(game,i);
-        fprintf(file, "#s:%d|%s|%s|%s|%s|%s|%s|%d|\n",space_get_id(s),space_get_name(s),space_get_gdes_from_index(s,0),space_get_gdes_from_index(s,1),space_get_gdes_from_index(s,2),space_get_gdes_from_index(s,3),space_get_gdes_from_index(s,4),space_get_discovered(s));
-       }  
-if(game_get_number_of_links(game)<0){
-    return ERROR;
-}
-    for(i=0;i<game_get_number_of_links(game);i++){
-        e=game_get_link_from_index(game,i);
-        fprintf(file,"#l:%d|%s|%d|%d|%d|\n",link_get_id(l),link_get_name(l),link_get_origin(l),link_get_destination(l),link_get_direction(l),link_get_open(l));
-    }
-
     return OK;
-}
\ No newline at end of file
+}
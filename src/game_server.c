@@ -0,0 +1,906 @@
+/**
+ * @brief Servidor que aloja varias partidas independientes en un proceso
+ *
+ * Cada conexión (TCP local o socket Unix) recibe su propio Game cargado
+ * del mismo mundo. Cada línea recibida se interpreta como un comando y se
+ * ejecuta con game_actions_update sobre la partida de esa sesión; la
+ * respuesta es la misma línea "entrada: OK|ERROR" que escribe el modo por
+ * lotes. Los comandos save y load responden ERROR: leerían o escribirían
+ * archivos del servidor elegidos por el cliente.
+ *
+ * Un único hilo multiplexa todos los sockets con epoll: solo se visitan las
+ * sesiones con actividad, las líneas se reconstruyen a trozos en el buffer
+ * de cada sesión y ningún socket se lee o escribe de forma bloqueante.
+ *
+ * Con -t las líneas se ejecutan en un conjunto de hilos: cada sesión es una
+ * cola serie del conjunto, así que sus comandos siguen en orden mientras
+ * sesiones distintas avanzan en paralelo. La carga del mundo de cada sesión
+ * es la primera tarea de su cola, de modo que una conexión nueva no detiene
+ * a epoll mientras se lee el archivo. Los hilos apuntan la sesión en la
+ * lista de terminadas y despiertan a epoll escribiendo en una tubería.
+ *
+ * @file game_server.c
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "command.h"
+#include "game.h"
+#include "game_actions.h"
+#include "worker_pool.h"
+
+#define SESSION_BUFFER 1024
+#define SESSION_OUT_LIMIT (64 * SESSION_BUFFER)
+#define LINE_TOO_LONG "line too long"
+#define INIT_SESSIONS 8
+#define LISTEN_BACKLOG 64
+#define MAX_EVENTS 256
+#define MAX_PORT 65535
+
+/**
+ * @brief Session
+ * Conexión de un cliente con su partida y sus buffers de entrada y salida.
+ */
+typedef struct _Session
+{
+  int fd;                    /*!< Descriptor del socket del cliente */
+  int index;                 /*!< Posicion en el vector de sesiones del servidor */
+  struct _Server *server;    /*!< Servidor al que pertenece */
+  unsigned int events;       /*!< Eventos registrados en epoll */
+  BOOL closed;               /*!< Ya cerrada, pendiente de liberar */
+  struct _Session *next_done;   /*!< Siguiente en la lista de terminadas */
+  struct _Session *next_closed; /*!< Siguiente en la lista de cerradas por liberar */
+  Game *game;                /*!< Partida propia de la sesion */
+  unsigned long seed;        /*!< Semilla de la partida, fijada al aceptar */
+  WorkerStrand *strand;      /*!< Cola serie en el conjunto de hilos o NULL */
+  char in[SESSION_BUFFER];   /*!< Bytes recibidos aun sin linea completa */
+  int in_len;                /*!< Numero de bytes validos en in */
+  BOOL discarding;           /*!< Se descarta el resto de una linea que no cabia en in */
+  pthread_mutex_t lock;      /*!< Protege out, closing, pending y notified */
+  char *out;                 /*!< Respuestas pendientes de enviar */
+  int out_len;               /*!< Numero de bytes pendientes en out */
+  int out_capacity;          /*!< Capacidad reservada de out */
+  int pending;               /*!< Lineas enviadas a los hilos aun sin ejecutar */
+  BOOL notified;             /*!< Esta en la lista de terminadas del servidor */
+  BOOL closing;              /*!< La sesion se cierra al vaciar out */
+} Session;
+
+/**
+ * @brief SessionLine
+ * Línea recibida que espera su turno en el conjunto de hilos.
+ */
+typedef struct _SessionLine
+{
+  Session *session;          /*!< Sesion a la que pertenece */
+  char *text;                /*!< Texto de la linea (reservado tras la estructura) o NULL si era demasiado larga */
+} SessionLine;
+
+/**
+ * @brief Server
+ * Socket de escucha y sesiones abiertas.
+ */
+typedef struct _Server
+{
+  int listen_fd;             /*!< Descriptor del socket de escucha */
+  int epoll_fd;              /*!< Descriptor de epoll */
+  int wake[2];               /*!< Tuberia con la que los hilos despiertan a epoll */
+  WorkerPool *pool;          /*!< Conjunto de hilos o NULL si se ejecuta en linea */
+  pthread_mutex_t done_lock; /*!< Protege done */
+  Session *done;             /*!< Sesiones con lineas terminadas por los hilos */
+  Session *graveyard;        /*!< Sesiones cerradas que se liberan al final de la vuelta */
+  char *unix_path;           /*!< Ruta del socket Unix o NULL si es TCP */
+  char *world;               /*!< Archivo del mundo que carga cada sesion */
+  Session **sessions;        /*!< Sesiones abiertas */
+  int n_sessions;            /*!< Numero de sesiones abiertas */
+  int capacity;              /*!< Capacidad reservada de sessions */
+  unsigned long n_accepted;  /*!< Conexiones aceptadas, para variar la semilla */
+} Server;
+
+static volatile sig_atomic_t game_server_stop = 0;
+
+void game_server_handle_signal(int signum);
+BOOL game_server_is_port(char *address);
+int game_server_listen_tcp(char *port);
+int game_server_listen_unix(char *path);
+Status game_server_set_nonblocking(int fd);
+Status game_server_watch(Server *server, Session *session, unsigned int events);
+Status game_server_accept(Server *server);
+void game_server_close_session(Server *server, Session *session);
+void game_server_free_closed(Server *server);
+void game_server_service(Server *server, Session *session);
+void game_server_drain_done(Server *server);
+Status game_server_queue(Session *session, char *text);
+Status game_server_flush(Session *session);
+Status game_server_load(Session *session);
+void game_server_load_task(void *arg);
+void game_server_notify(Session *session);
+void game_server_process_line(Session *session, char *line);
+void game_server_run_line(void *arg);
+void game_server_dispatch(Server *server, Session *session, char *line);
+Status game_server_read(Server *server, Session *session);
+int game_server_run(Server *server);
+
+void game_server_handle_signal(int signum)
+{
+  (void)signum;
+  game_server_stop = 1;
+}
+
+BOOL game_server_is_port(char *address)
+{
+  int i;
+
+  if (!address || address[0] == '\0')
+  {
+    return FALSE;
+  }
+
+  for (i = 0; address[i] != '\0'; i++)
+  {
+    if (address[i] < '0' || address[i] > '9')
+    {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+Status game_server_set_nonblocking(int fd)
+{
+  int flags;
+
+  flags = fcntl(fd, F_GETFL, 0);
+  if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+  {
+    return ERROR;
+  }
+  return OK;
+}
+
+int game_server_listen_tcp(char *port)
+{
+  struct sockaddr_in addr;
+  long number;
+  int fd, reuse = 1;
+
+  number = strtol(port, NULL, 10);
+  if (number <= 0 || number > MAX_PORT)
+  {
+    return -1;
+  }
+
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    return -1;
+  }
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  /* Solo se escucha en la interfaz local */
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons((unsigned short)number);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, LISTEN_BACKLOG) < 0)
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+int game_server_listen_unix(char *path)
+{
+  struct sockaddr_un addr;
+  int fd;
+
+  if (strlen(path) >= sizeof(addr.sun_path))
+  {
+    return -1;
+  }
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    return -1;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+
+  /* Elimina un socket que haya quedado de una ejecucion anterior */
+  unlink(path);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, LISTEN_BACKLOG) < 0)
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+Status game_server_watch(Server *server, Session *session, unsigned int events)
+{
+  struct epoll_event event;
+  int op;
+
+  /* Solo se llama al sistema si cambia el interes de la sesion */
+  if (session->events == events)
+  {
+    return OK;
+  }
+
+  /*
+   * Sin interes el socket sale de epoll: EPOLLHUP y EPOLLERR se avisan
+   * siempre, y un cliente colgado haria girar el bucle mientras los hilos
+   * terminan sus lineas. La lista de terminadas sigue llegando por wake.
+   */
+  op = (events == 0) ? EPOLL_CTL_DEL : (session->events == 0) ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+  memset(&event, 0, sizeof(event));
+  event.events = events;
+  event.data.ptr = session;
+  if (epoll_ctl(server->epoll_fd, op, session->fd, &event) < 0)
+  {
+    return ERROR;
+  }
+  session->events = events;
+  return OK;
+}
+
+Status game_server_accept(Server *server)
+{
+  Session *session = NULL, **sessions = NULL;
+  struct epoll_event event;
+  int fd;
+
+  if (!server)
+  {
+    return ERROR;
+  }
+
+  fd = accept(server->listen_fd, NULL, NULL);
+  if (fd < 0)
+  {
+    return ERROR;
+  }
+
+  if (game_server_set_nonblocking(fd) == ERROR || (session = (Session *)calloc(1, sizeof(Session))) == NULL)
+  {
+    close(fd);
+    return ERROR;
+  }
+  session->fd = fd;
+  session->server = server;
+
+  /* Con hilos, cada sesion tiene su cola serie para no desordenar comandos */
+  if (server->pool && (session->strand = worker_pool_strand_create(server->pool)) == NULL)
+  {
+    free(session);
+    close(fd);
+    return ERROR;
+  }
+
+  /* Cada sesion juega su propia partida con su propia semilla */
+  server->n_accepted++;
+  session->seed = (unsigned long)time(NULL) ^ server->n_accepted;
+  if (!server->pool && game_server_load(session) == ERROR)
+  {
+    free(session);
+    close(fd);
+    return ERROR;
+  }
+
+  /* Duplica el vector de sesiones cuando se llena */
+  if (server->n_sessions == server->capacity)
+  {
+    sessions = (Session **)realloc(server->sessions, 2 * server->capacity * sizeof(Session *));
+    if (sessions)
+    {
+      server->sessions = sessions;
+      server->capacity *= 2;
+    }
+  }
+
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.ptr = session;
+  if (server->n_sessions == server->capacity || epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+  {
+    game_destroy(session->game);
+    worker_pool_strand_destroy(session->strand);
+    free(session);
+    close(fd);
+    return ERROR;
+  }
+  session->events = EPOLLIN;
+
+  pthread_mutex_init(&session->lock, NULL);
+  session->index = server->n_sessions;
+  server->sessions[server->n_sessions] = session;
+  server->n_sessions++;
+
+  /*
+   * Con hilos la partida se carga en la cola de la sesion: las lineas que
+   * lleguen antes esperan detras de la carga.
+   */
+  if (server->pool)
+  {
+    session->pending = 1;
+    if (worker_pool_submit(session->strand, game_server_load_task, session) == ERROR)
+    {
+      session->pending = 0;
+      session->closing = TRUE;
+    }
+  }
+  return OK;
+}
+
+void game_server_close_session(Server *server, Session *session)
+{
+  Session *last = NULL;
+
+  /* Deja de vigilar el socket (si seguia en epoll) y saca la sesion del vector */
+  if (session->events != 0)
+  {
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, session->fd, NULL);
+  }
+  server->n_sessions--;
+  last = server->sessions[server->n_sessions];
+  server->sessions[session->index] = last;
+  last->index = session->index;
+
+  /*
+   * Puede haber mas eventos suyos en la misma vuelta de epoll_wait: se marca
+   * y se libera al final de la vuelta.
+   */
+  session->closed = TRUE;
+  session->next_closed = server->graveyard;
+  server->graveyard = session;
+}
+
+void game_server_free_closed(Server *server)
+{
+  Session *session = NULL;
+
+  while (server->graveyard)
+  {
+    session = server->graveyard;
+    server->graveyard = session->next_closed;
+
+    /* Espera a que el hilo que la ejecuto la suelte antes de liberar la partida */
+    worker_pool_strand_destroy(session->strand);
+    close(session->fd);
+    game_destroy(session->game);
+    pthread_mutex_destroy(&session->lock);
+    free(session->out);
+    free(session);
+  }
+}
+
+void game_server_service(Server *server, Session *session)
+{
+  unsigned int events;
+  BOOL done;
+
+  pthread_mutex_lock(&session->lock);
+  if (game_server_flush(session) == ERROR)
+  {
+    session->closing = TRUE;
+    session->out_len = 0;
+  }
+  done = session->closing && session->out_len == 0 && session->pending == 0 && !session->notified;
+
+  /* Un cliente que no lee sus respuestas deja de ser leido hasta que las recoja */
+  events = (session->closing || session->out_len >= SESSION_OUT_LIMIT ? 0 : EPOLLIN) | (session->out_len > 0 ? EPOLLOUT : 0);
+  pthread_mutex_unlock(&session->lock);
+
+  if (done || game_server_watch(server, session, events) == ERROR)
+  {
+    game_server_close_session(server, session);
+  }
+}
+
+void game_server_drain_done(Server *server)
+{
+  Session *session = NULL, *next = NULL;
+  char drain[SESSION_BUFFER];
+
+  /* Vacia la tuberia: los avisos concretos estan en la lista */
+  while (read(server->wake[0], drain, sizeof(drain)) > 0)
+    ;
+
+  pthread_mutex_lock(&server->done_lock);
+  session = server->done;
+  server->done = NULL;
+  pthread_mutex_unlock(&server->done_lock);
+
+  for (; session; session = next)
+  {
+    pthread_mutex_lock(&session->lock);
+    next = session->next_done;
+    session->notified = FALSE;
+    pthread_mutex_unlock(&session->lock);
+
+    game_server_service(server, session);
+  }
+}
+
+Status game_server_queue(Session *session, char *text)
+{
+  char *out = NULL;
+  int len, capacity;
+
+  len = (int)strlen(text);
+  if (session->out_len + len > session->out_capacity)
+  {
+    capacity = session->out_capacity ? session->out_capacity : SESSION_BUFFER;
+    while (capacity < session->out_len + len)
+    {
+      capacity *= 2;
+    }
+    out = (char *)realloc(session->out, capacity);
+    if (!out)
+    {
+      return ERROR;
+    }
+    session->out = out;
+    session->out_capacity = capacity;
+  }
+
+  memcpy(session->out + session->out_len, text, len);
+  session->out_len += len;
+  return OK;
+}
+
+Status game_server_flush(Session *session)
+{
+  ssize_t written;
+
+  while (session->out_len > 0)
+  {
+    written = write(session->fd, session->out, session->out_len);
+    if (written < 0)
+    {
+      /* El resto se envia cuando el socket vuelva a admitir escritura */
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+      {
+        return OK;
+      }
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return ERROR;
+    }
+    session->out_len -= (int)written;
+    memmove(session->out, session->out + written, session->out_len);
+  }
+  return OK;
+}
+
+Status game_server_load(Session *session)
+{
+  if (game_create_from_file(&session->game, session->server->world) == ERROR)
+  {
+    return ERROR;
+  }
+  game_set_seed(session->game, session->seed);
+  return OK;
+}
+
+void game_server_load_task(void *arg)
+{
+  Session *session = (Session *)arg;
+
+  /* Sin partida la sesion se cierra sin ejecutar ninguna linea */
+  if (game_server_load(session) == ERROR)
+  {
+    fprintf(stderr, "Error while loading %s.\n", session->server->world);
+    pthread_mutex_lock(&session->lock);
+    session->closing = TRUE;
+    pthread_mutex_unlock(&session->lock);
+  }
+  game_server_notify(session);
+}
+
+void game_server_notify(Session *session)
+{
+  Server *server = session->server;
+  char byte = 0;
+  BOOL wake = FALSE;
+
+  /*
+   * Se apunta en la lista de terminadas sin soltar la sesion: mientras
+   * notified sea TRUE el bucle principal no puede cerrarla.
+   */
+  pthread_mutex_lock(&session->lock);
+  session->pending--;
+  if (session->notified == FALSE)
+  {
+    session->notified = TRUE;
+    pthread_mutex_lock(&server->done_lock);
+    session->next_done = server->done;
+    wake = server->done == NULL;
+    server->done = session;
+    pthread_mutex_unlock(&server->done_lock);
+  }
+  pthread_mutex_unlock(&session->lock);
+
+  /* Basta un byte por lista; si la tuberia esta llena ya hay un aviso pendiente */
+  if (wake == TRUE && write(server->wake[1], &byte, 1) < 0)
+  {
+    return;
+  }
+}
+
+void game_server_process_line(Session *session, char *line)
+{
+  char reply[SESSION_BUFFER + WORD_SIZE] = "";
+  char *last_input = NULL;
+  Game *game = session->game;
+  Command *command = NULL;
+  BOOL closing;
+
+  /* Las lineas que llegan tras la salida se descartan */
+  pthread_mutex_lock(&session->lock);
+  closing = session->closing;
+  pthread_mutex_unlock(&session->lock);
+  if (closing == TRUE)
+  {
+    return;
+  }
+
+  /* Una linea demasiado larga no se ejecuta, ni siquiera en parte */
+  if (line == NULL)
+  {
+    sprintf(reply, "%s: ERROR\n", LINE_TOO_LONG);
+    pthread_mutex_lock(&session->lock);
+    if (game_server_queue(session, reply) == ERROR)
+    {
+      session->closing = TRUE;
+    }
+    pthread_mutex_unlock(&session->lock);
+    return;
+  }
+
+  /*
+   * Mismo ciclo que el bucle por lotes, con el comando de esta partida. Un
+   * cliente no elige archivos del servidor: guardar y cargar se rechazan
+   * sin ejecutarse.
+   */
+  command = game_get_last_command(game);
+  command_parse_input(command, line);
+  if (command_get_code(command) == SAVE || command_get_code(command) == LOAD)
+  {
+    game_set_last_command_status(game, ERROR);
+  }
+  else
+  {
+    game_set_last_command_status(game, game_actions_update(game, command));
+  }
+
+  last_input = command_get_last_input(command);
+  last_input[strcspn(last_input, "\r\n")] = '\0';
+  sprintf(reply, "%s: %s\n", last_input, game_get_last_command_status(game) == OK ? "OK" : "ERROR");
+
+  pthread_mutex_lock(&session->lock);
+  if (game_server_queue(session, reply) == ERROR || command_get_code(command) == EXIT || game_get_finished(game))
+  {
+    session->closing = TRUE;
+  }
+  closing = session->closing;
+  pthread_mutex_unlock(&session->lock);
+
+  if (closing == FALSE)
+  {
+    game_actions_update_turn(game, command);
+  }
+}
+
+void game_server_run_line(void *arg)
+{
+  SessionLine *line = (SessionLine *)arg;
+  Session *session = line->session;
+
+  game_server_process_line(session, line->text);
+  free(line);
+  game_server_notify(session);
+}
+
+void game_server_dispatch(Server *server, Session *session, char *line)
+{
+  SessionLine *task = NULL;
+  size_t len;
+
+  /* Sin conjunto de hilos la linea se ejecuta aqui mismo */
+  if (!server->pool)
+  {
+    game_server_process_line(session, line);
+    return;
+  }
+
+  len = line ? strlen(line) + 1 : 0;
+  task = (SessionLine *)malloc(sizeof(SessionLine) + len);
+  if (!task)
+  {
+    pthread_mutex_lock(&session->lock);
+    session->closing = TRUE;
+    pthread_mutex_unlock(&session->lock);
+    return;
+  }
+  task->session = session;
+  task->text = NULL;
+  if (line)
+  {
+    task->text = (char *)(task + 1);
+    memcpy(task->text, line, len);
+  }
+
+  pthread_mutex_lock(&session->lock);
+  session->pending++;
+  pthread_mutex_unlock(&session->lock);
+
+  if (worker_pool_submit(session->strand, game_server_run_line, task) == ERROR)
+  {
+    pthread_mutex_lock(&session->lock);
+    session->pending--;
+    session->closing = TRUE;
+    pthread_mutex_unlock(&session->lock);
+    free(task);
+  }
+}
+
+Status game_server_read(Server *server, Session *session)
+{
+  ssize_t n;
+  char *start = NULL, *end = NULL, *last = NULL;
+
+  n = read(session->fd, session->in + session->in_len, SESSION_BUFFER - 1 - session->in_len);
+  if (n < 0)
+  {
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? OK : ERROR;
+  }
+  if (n == 0)
+  {
+    /* El cliente ha cerrado su extremo: equivale al fin de archivo */
+    return ERROR;
+  }
+  session->in_len += (int)n;
+  session->in[session->in_len] = '\0';
+
+  /*
+   * Ejecuta (o encola) cada linea completa en el orden de llegada. Se busca
+   * sobre los bytes recibidos y no sobre la cadena: un '\0' enviado por el
+   * cliente no debe ocultar los saltos de linea que le siguen.
+   */
+  start = session->in;
+  last = session->in + session->in_len;
+  while ((end = (char *)memchr(start, '\n', last - start)) != NULL)
+  {
+    *end = '\0';
+    if (session->discarding == TRUE)
+    {
+      /* Fin de la linea demasiado larga, que ya tuvo su respuesta */
+      session->discarding = FALSE;
+    }
+    else
+    {
+      game_server_dispatch(server, session, start);
+    }
+    start = end + 1;
+  }
+  session->in_len -= (int)(start - session->in);
+  memmove(session->in, start, session->in_len);
+
+  /*
+   * Una linea que no cabe en el buffer no se ejecuta: se responde ERROR una
+   * vez y se descartan sus bytes hasta el siguiente salto de linea.
+   */
+  if (session->in_len == SESSION_BUFFER - 1)
+  {
+    if (session->discarding == FALSE)
+    {
+      game_server_dispatch(server, session, NULL);
+      session->discarding = TRUE;
+    }
+    session->in_len = 0;
+  }
+
+  return OK;
+}
+
+int game_server_run(Server *server)
+{
+  struct epoll_event events[MAX_EVENTS];
+  Session *session = NULL;
+  int n_events, i, result = 0;
+
+  while (!game_server_stop)
+  {
+    n_events = epoll_wait(server->epoll_fd, events, MAX_EVENTS, -1);
+    if (n_events < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      result = 1;
+      break;
+    }
+
+    for (i = 0; i < n_events; i++)
+    {
+      /* Conexiones nuevas: se aceptan todas las que esperan */
+      if (events[i].data.ptr == &server->listen_fd)
+      {
+        while (game_server_accept(server) == OK)
+          ;
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+          fprintf(stderr, "Error while accepting session.\n");
+        }
+        continue;
+      }
+
+      /* Aviso de los hilos: solo se visitan las sesiones de la lista */
+      if (events[i].data.ptr == &server->wake[0])
+      {
+        game_server_drain_done(server);
+        continue;
+      }
+
+      session = (Session *)events[i].data.ptr;
+      if (session->closed == TRUE)
+      {
+        continue;
+      }
+
+      /* Sin EPOLLIN registrado (salida llena) los avisos de cierre los detecta la escritura */
+      if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && (session->events & EPOLLIN))
+      {
+        if (game_server_read(server, session) == ERROR)
+        {
+          /* Cliente perdido: se descarta lo pendiente de enviar */
+          pthread_mutex_lock(&session->lock);
+          session->closing = TRUE;
+          session->out_len = 0;
+          pthread_mutex_unlock(&session->lock);
+        }
+      }
+      game_server_service(server, session);
+    }
+
+    game_server_free_closed(server);
+  }
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  Server server;
+  struct sigaction action;
+  struct epoll_event event;
+  char *endptr = NULL;
+  long n_threads = 0;
+  int result;
+
+  /* Comprueba los argumentos de entrada */
+  if (argc == 5 && strcmp(argv[3], "-t") == 0)
+  {
+    n_threads = strtol(argv[4], &endptr, 10);
+  }
+  if ((argc != 3 && argc != 5) || n_threads < 0 || (endptr && *endptr != '\0'))
+  {
+    fprintf(stderr, "Uso: %s <game_data_file> <port|socket_path> [-t <n_threads>]\n", argv[0]);
+    return 1;
+  }
+
+  memset(&server, 0, sizeof(server));
+  server.world = argv[1];
+  server.wake[0] = server.wake[1] = -1;
+  pthread_mutex_init(&server.done_lock, NULL);
+
+  /* Un cliente que desaparece no debe terminar el proceso */
+  signal(SIGPIPE, SIG_IGN);
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = game_server_handle_signal;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  /* Un numero es un puerto TCP local; cualquier otra cosa, un socket Unix */
+  if (game_server_is_port(argv[2]))
+  {
+    server.listen_fd = game_server_listen_tcp(argv[2]);
+  }
+  else
+  {
+    server.unix_path = argv[2];
+    server.listen_fd = game_server_listen_unix(argv[2]);
+  }
+  if (server.listen_fd < 0 || game_server_set_nonblocking(server.listen_fd) == ERROR)
+  {
+    fprintf(stderr, "Error while opening socket %s.\n", argv[2]);
+    return 1;
+  }
+
+  /* La tuberia de aviso se vigila aunque no haya hilos: nunca se activa */
+  if (pipe(server.wake) < 0 || game_server_set_nonblocking(server.wake[0]) == ERROR || game_server_set_nonblocking(server.wake[1]) == ERROR)
+  {
+    fprintf(stderr, "Error while creating wake pipe.\n");
+    close(server.listen_fd);
+    return 1;
+  }
+
+  /* Registro en epoll del socket de escucha y de la tuberia */
+  server.epoll_fd = epoll_create(MAX_EVENTS);
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.ptr = &server.listen_fd;
+  if (server.epoll_fd < 0 || epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.listen_fd, &event) < 0)
+  {
+    fprintf(stderr, "Error while creating epoll instance.\n");
+    close(server.listen_fd);
+    return 1;
+  }
+  event.data.ptr = &server.wake[0];
+  epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.wake[0], &event);
+
+  /* Conjunto de hilos opcional */
+  if (n_threads > 0 && (server.pool = worker_pool_create((int)n_threads)) == NULL)
+  {
+    fprintf(stderr, "Error while starting %ld worker threads.\n", n_threads);
+    close(server.listen_fd);
+    return 1;
+  }
+
+  server.capacity = INIT_SESSIONS;
+  if ((server.sessions = (Session **)malloc(server.capacity * sizeof(Session *))) == NULL)
+  {
+    worker_pool_destroy(server.pool);
+    close(server.listen_fd);
+    return 1;
+  }
+
+  result = game_server_run(&server);
+
+  /* Liberacion de todas las sesiones abiertas */
+  while (server.n_sessions > 0)
+  {
+    game_server_close_session(&server, server.sessions[server.n_sessions - 1]);
+  }
+  game_server_free_closed(&server);
+  free(server.sessions);
+  worker_pool_destroy(server.pool);
+  close(server.epoll_fd);
+  close(server.wake[0]);
+  close(server.wake[1]);
+  close(server.listen_fd);
+  pthread_mutex_destroy(&server.done_lock);
+  if (server.unix_path)
+  {
+    unlink(server.unix_path);
+  }
+
+  return result;
+}
@@ -0,0 +1,218 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "types.h"
+#include "game_server_test.h"
+#include "test.h"
+#define MAX_TESTS 6
+#define SERVER "./castle_server"
+#define WORLD "castle.dat"
+#define CONNECT_TRIES 200
+#define REPLY_SIZE 256
+#define PATH_SIZE 64
+#define LONG_LINE 1500
+
+/* Servidor de prueba: un proceso castle_server escuchando en un socket Unix */
+typedef struct
+{
+  pid_t pid;
+  char path[PATH_SIZE];
+} TestServer;
+
+Status test_game_server_start(TestServer *server, char *threads);
+void test_game_server_stop(TestServer *server);
+int test_game_server_connect(TestServer *server);
+Status test_game_server_send(int fd, char *line, char *reply);
+
+Status test_game_server_start(TestServer *server, char *threads)
+{
+  sprintf(server->path, "/tmp/castle_server_test_%ld.sock", (long)getpid());
+  server->pid = fork();
+  if (server->pid < 0)
+  {
+    return ERROR;
+  }
+  if (server->pid == 0)
+  {
+    /* Con threads la partida se carga y se juega en el conjunto de hilos */
+    if (threads)
+    {
+      execl(SERVER, SERVER, WORLD, server->path, "-t", threads, (char *)NULL);
+    }
+    else
+    {
+      execl(SERVER, SERVER, WORLD, server->path, (char *)NULL);
+    }
+    _exit(1);
+  }
+  return OK;
+}
+
+void test_game_server_stop(TestServer *server)
+{
+  kill(server->pid, SIGTERM);
+  waitpid(server->pid, NULL, 0);
+}
+
+int test_game_server_connect(TestServer *server)
+{
+  struct sockaddr_un addr;
+  struct timespec pause = {0, 10000000L};
+  int fd, i;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, server->path);
+
+  /* El servidor tarda un poco en crear el socket */
+  for (i = 0; i < CONNECT_TRIES; i++)
+  {
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+      return -1;
+    }
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+    {
+      return fd;
+    }
+    close(fd);
+    nanosleep(&pause, NULL);
+  }
+  return -1;
+}
+
+Status test_game_server_send(int fd, char *line, char *reply)
+{
+  ssize_t n;
+  int len = 0;
+
+  if (write(fd, line, strlen(line)) != (ssize_t)strlen(line))
+  {
+    return ERROR;
+  }
+
+  /* Cada linea enviada tiene exactamente una linea de respuesta */
+  while (len < REPLY_SIZE - 1 && (len == 0 || reply[len - 1] != '\n'))
+  {
+    n = read(fd, reply + len, REPLY_SIZE - 1 - len);
+    if (n <= 0)
+    {
+      return ERROR;
+    }
+    len += (int)n;
+  }
+  reply[len] = '\0';
+  return OK;
+}
+
+int main(int argc, char** argv) {
+    int test = 0;
+    if (argc > 1) test = atoi(argv[1]);
+    if (test < 0 || test > MAX_TESTS) {
+        printf("Error: unknown test %d\t", test);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (test == 0 || test == 1) test1_game_server_save();
+    if (test == 0 || test == 2) test2_game_server_save();
+    if (test == 0 || test == 3) test1_game_server_load();
+    if (test == 0 || test == 4) test1_game_server_exit();
+    if (test == 0 || test == 5) test1_game_server_read();
+    if (test == 0 || test == 6) test2_game_server_exit();
+
+    PRINT_PASSED_PERCENTAGE;
+    return 0;
+}
+
+void test1_game_server_save() {
+    TestServer server;
+    char line[REPLY_SIZE], reply[REPLY_SIZE] = "", expected[REPLY_SIZE];
+    char file[PATH_SIZE];
+    int fd = -1;
+
+    sprintf(file, "/tmp/castle_server_test_%ld.dat", (long)getpid());
+    remove(file);
+    sprintf(line, "save %s\n", file);
+    sprintf(expected, "save %s: ERROR\n", file);
+    if (test_game_server_start(&server, NULL) == OK) fd = test_game_server_connect(&server);
+    PRINT_TEST_RESULT(fd >= 0 && test_game_server_send(fd, line, reply) == OK && strcmp(reply, expected) == 0);
+    if (fd >= 0) close(fd);
+    test_game_server_stop(&server);
+}
+
+void test2_game_server_save() {
+    TestServer server;
+    char line[REPLY_SIZE], reply[REPLY_SIZE] = "", file[PATH_SIZE];
+    int fd = -1;
+
+    /* El archivo pedido por el cliente no llega a crearse */
+    sprintf(file, "/tmp/castle_server_test_%ld.dat", (long)getpid());
+    remove(file);
+    sprintf(line, "save %s\n", file);
+    if (test_game_server_start(&server, NULL) == OK) fd = test_game_server_connect(&server);
+    if (fd >= 0) test_game_server_send(fd, line, reply);
+    PRINT_TEST_RESULT(fd >= 0 && access(file, F_OK) != 0);
+    if (fd >= 0) close(fd);
+    test_game_server_stop(&server);
+    remove(file);
+}
+
+void test1_game_server_load() {
+    TestServer server;
+    char reply[REPLY_SIZE] = "";
+    int fd = -1;
+
+    if (test_game_server_start(&server, NULL) == OK) fd = test_game_server_connect(&server);
+    PRINT_TEST_RESULT(fd >= 0 && test_game_server_send(fd, "load " WORLD "\n", reply) == OK && strcmp(reply, "load " WORLD ": ERROR\n") == 0);
+    if (fd >= 0) close(fd);
+    test_game_server_stop(&server);
+}
+
+void test1_game_server_exit() {
+    TestServer server;
+    char reply[REPLY_SIZE] = "";
+    int fd = -1;
+
+    /* El resto de comandos se siguen ejecutando */
+    if (test_game_server_start(&server, NULL) == OK) fd = test_game_server_connect(&server);
+    PRINT_TEST_RESULT(fd >= 0 && test_game_server_send(fd, "exit\n", reply) == OK && strcmp(reply, "exit: OK\n") == 0);
+    if (fd >= 0) close(fd);
+    test_game_server_stop(&server);
+}
+
+void test1_game_server_read() {
+    TestServer server;
+    char line[LONG_LINE + 1], first[REPLY_SIZE] = "", second[REPLY_SIZE] = "";
+    int fd = -1;
+
+    /* Una linea que no cabe en el buffer del servidor: su final seria un exit valido */
+    memset(line, 'a', LONG_LINE);
+    strcpy(line + LONG_LINE - strlen("exit\n"), "exit\n");
+    if (test_game_server_start(&server, NULL) == OK) fd = test_game_server_connect(&server);
+    if (fd >= 0) test_game_server_send(fd, line, first);
+    PRINT_TEST_RESULT(fd >= 0 && strcmp(first, "line too long: ERROR\n") == 0 && test_game_server_send(fd, "exit\n", second) == OK && strcmp(second, "exit: OK\n") == 0);
+    if (fd >= 0) close(fd);
+    test_game_server_stop(&server);
+}
+
+void test2_game_server_exit() {
+    TestServer server;
+    char first[REPLY_SIZE] = "", second[REPLY_SIZE] = "";
+    int fd = -1;
+
+    /* Con hilos, las lineas esperan a que la partida termine de cargarse */
+    if (test_game_server_start(&server, "2") == OK) fd = test_game_server_connect(&server);
+    PRINT_TEST_RESULT(fd >= 0 && test_game_server_send(fd, "take Espada\n", first) == OK && strcmp(first, "take Espada: OK\n") == 0 && test_game_server_send(fd, "exit\n", second) == OK && strcmp(second, "exit: OK\n") == 0);
+    if (fd >= 0) close(fd);
+    test_game_server_stop(&server);
+}
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "game.h"
+#include "game_actions.h"
+#include "game_managment.h"
+#include "space.h"
+#include "player.h"
+#include "object.h"
+#include "link.h"
+#include "game_test.h"
+#include "test.h"
+#define MAX_TESTS 10
+#define WORLD "castle.dat"
+#define IMAGE "/tmp/castle_game_test.wld"
+#define START_OBJECT "Espada"
+#define START_OBJECT_ID 21
+
+BOOL test_game_membership_agrees(Game *game);
+Link *test_game_add_link(Game *game, Id id, Id origin, Id destination, Directions dir);
+Status test_game_run(Game *game, char *line);
+
+/*
+ * Los objetos de cada espacio y de la mochila se guardan dos veces: en el
+ * Set de la entidad y en el mapa de bits de la partida. Ambos deben decir
+ * lo mismo para todos los pares espacio-objeto.
+ */
+BOOL test_game_membership_agrees(Game *game)
+{
+  Space *space = NULL;
+  Player *player = NULL;
+  Id object_id;
+  int i, j;
+  BOOL in_set;
+
+  for (i = 0; i < game_get_number_of_objects(game); i++)
+  {
+    object_id = object_get_id(game_get_object_from_index(game, i));
+    for (j = 0; j < game_get_number_of_space(game); j++)
+    {
+      space = game_get_space_from_index(game, j);
+      in_set = (space_contains_object(space, object_id) == OK) ? TRUE : FALSE;
+      if (game_space_has_object(game, space_get_id(space), object_id) != in_set)
+      {
+        return FALSE;
+      }
+    }
+
+    player = game_get_player(game);
+    if (game_player_has_object(game, object_id) != player_has_object(player, object_id))
+    {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+Link *test_game_add_link(Game *game, Id id, Id origin, Id destination, Directions dir)
+{
+  Link *link = link_create_in(game_get_arena(game), id);
+
+  link_set_origin(link, origin);
+  link_set_destination(link, destination);
+  link_set_direction(link, dir);
+  game_add_link(game, link);
+  return link;
+}
+
+Status test_game_run(Game *game, char *line)
+{
+  Command *command = game_get_last_command(game);
+
+  command_parse_input(command, line);
+  return game_actions_update(game, command);
+}
+
+int main(int argc, char** argv) {
+    int test = 0;
+    if (argc > 1) test = atoi(argv[1]);
+    if (test < 0 || test > MAX_TESTS) {
+        printf("Error: unknown test %d\t", test);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (test == 0 || test == 1) test1_game_create_from_file();
+    if (test == 0 || test == 2) test2_game_create_from_file();
+    if (test == 0 || test == 3) test3_game_create_from_file();
+    if (test == 0 || test == 4) test1_game_player_add_object();
+    if (test == 0 || test == 5) test1_game_player_del_object();
+    if (test == 0 || test == 6) test1_game_player_has_object();
+    if (test == 0 || test == 7) test1_game_set_object_location();
+    if (test == 0 || test == 8) test1_game_add_space();
+    if (test == 0 || test == 9) test1_game_managment_compile_world();
+    if (test == 0 || test == 10) test2_game_managment_compile_world();
+
+    PRINT_PASSED_PERCENTAGE;
+    return 0;
+}
+
+void test1_game_create_from_file() {
+    Game *g = NULL;
+    PRINT_TEST_RESULT(game_create_from_file(&g, WORLD) == OK && game_space_has_object(g, 11, START_OBJECT_ID) == TRUE && test_game_membership_agrees(g) == TRUE);
+    game_destroy(g);
+}
+
+void test2_game_create_from_file() {
+    Game *g = NULL, *image = NULL;
+    /* La imagen compilada coloca los objetos por posicion, sin pasar por sus Ids */
+    if (game_create_from_file(&g, WORLD) == OK) game_managment_compile_world(g, IMAGE);
+    PRINT_TEST_RESULT(game_create_from_file(&image, IMAGE) == OK && game_space_has_object(image, 11, START_OBJECT_ID) == TRUE && test_game_membership_agrees(image) == TRUE);
+    game_destroy(image);
+    game_destroy(g);
+    remove(IMAGE);
+}
+
+void test3_game_create_from_file() {
+    Game *g = NULL;
+    PRINT_TEST_RESULT(game_create_from_file(&g, "missing.dat") == ERROR && g == NULL);
+}
+
+void test1_game_player_add_object() {
+    Game *g = NULL;
+    game_create_from_file(&g, WORLD);
+    PRINT_TEST_RESULT(test_game_run(g, "take " START_OBJECT) == OK && game_player_has_object(g, START_OBJECT_ID) == TRUE && game_space_has_object(g, 11, START_OBJECT_ID) == FALSE && test_game_membership_agrees(g) == TRUE);
+    game_destroy(g);
+}
+
+void test1_game_player_del_object() {
+    Game *g = NULL;
+    game_create_from_file(&g, WORLD);
+    test_game_run(g, "take " START_OBJECT);
+    PRINT_TEST_RESULT(test_game_run(g, "drop " START_OBJECT) == OK && game_player_has_object(g, START_OBJECT_ID) == FALSE && game_space_has_object(g, 11, START_OBJECT_ID) == TRUE && test_game_membership_agrees(g) == TRUE);
+    game_destroy(g);
+}
+
+void test1_game_player_has_object() {
+    Game *g = NULL;
+    game_create_from_file(&g, WORLD);
+    test_game_run(g, "take " START_OBJECT);
+    PRINT_TEST_RESULT(test_game_run(g, "use " START_OBJECT) == OK && test_game_membership_agrees(g) == TRUE);
+    game_destroy(g);
+}
+
+void test1_game_set_object_location() {
+    Game *g = NULL;
+    game_create_from_file(&g, WORLD);
+    /* Mover y sacar del mapa actualiza el Set y el bit a la vez */
+    PRINT_TEST_RESULT(game_set_object_location(g, 12, START_OBJECT_ID) == OK && test_game_membership_agrees(g) == TRUE && game_set_object_location(g, NO_ID, START_OBJECT_ID) == OK && game_space_has_object(g, 11, START_OBJECT_ID) == FALSE && game_space_has_object(g, 12, START_OBJECT_ID) == FALSE && test_game_membership_agrees(g) == TRUE);
+    game_destroy(g);
+}
+
+void test1_game_add_space() {
+    Game *g = NULL;
+    Space *s = NULL;
+    /* Un espacio del heap convive con los del almacen y se libera aparte */
+    game_create_from_file(&g, WORLD);
+    s = space_create(999);
+    PRINT_TEST_RESULT(game_add_space(g, s) == OK && game_get_space(g, 999) == s && space_get_arena(s) == NULL);
+    game_destroy(g);
+}
+
+void test1_game_managment_compile_world() {
+    Game *g = NULL;
+    Link *l = NULL;
+    int dir = 0;
+    /* Segundo enlace en una direccion ya ocupada del espacio inicial */
+    game_create_from_file(&g, WORLD);
+    while (dir < N_DIRECTIONS && space_get_link_at(game_get_space(g, 11), (Directions)dir) == NULL) dir++;
+    l = space_get_link_at(game_get_space(g, 11), (Directions)dir);
+    test_game_add_link(g, 999, 11, link_get_destination(l), (Directions)dir);
+    remove(IMAGE);
+    PRINT_TEST_RESULT(l != NULL && game_managment_compile_world(g, IMAGE) == ERROR && remove(IMAGE) != 0);
+    game_destroy(g);
+}
+
+void test2_game_managment_compile_world() {
+    Game *g = NULL;
+    /* Enlace hacia un espacio que no existe */
+    game_create_from_file(&g, WORLD);
+    test_game_add_link(g, 999, 11, 9999, N);
+    remove(IMAGE);
+    PRINT_TEST_RESULT(game_managment_compile_world(g, IMAGE) == ERROR && remove(IMAGE) != 0);
+    game_destroy(g);
+}
@@ -8,6 +8,8 @@
  * @copyright GNU Public License
  */
 
+#define _POSIX_C_SOURCE 200112L
+
 #include "graphic_engine.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -19,6 +21,7 @@
 #include "character.h"
 #include "player.h"
 #include "object.h"
+#include "id_map.h"
 
 #define WIDTH_MAP 67
 #define WIDTH_DES 55
@@ -27,30 +30,103 @@
 #define HEIGHT_BAN 1
 #define HEIGHT_HLP 2
 #define HEIGHT_FDB 3
-#define MAX_OBJECTS 100
 #define ROOM_WIDTH 19
+#define SCREEN_ROWS (HEIGHT_MAP + HEIGHT_BAN + HEIGHT_HLP + HEIGHT_FDB + 4)
+#define SCREEN_COLUMNS (WIDTH_MAP + WIDTH_DES + 3)
+#define FOOTER_MAX 16
+#define AREA_TEXT 8192
+#define TILE_ROWS (GDESC_ROWS + 4)
+#define TILE_WIDTH 25
+#define MIN_TILES 16
+#define SIDE_BLANK "                     "
+
+/**
+ * @brief AreaText
+ * Lineas de un area separadas por '\n', tal y como se mandarian a libscreen.
+ */
+typedef struct _AreaText
+{
+    char text[AREA_TEXT]; /*!< Contenido del area */
+    int len;              /*!< Bytes usados, -1 si nunca se ha pintado */
+} AreaText;
+
+/**
+ * @brief TileKind
+ * Posicion en la que se pinta una sala, que cambia su formato.
+ */
+typedef enum
+{
+    TILE_SIDE,   /*!< Sala al oeste o al este de la fila */
+    TILE_MIDDLE, /*!< Sala central de una fila */
+    TILE_ACTIVE, /*!< Sala central donde esta el jugador */
+    N_TILE_KINDS
+} TileKind;
+
+/**
+ * @brief RoomTile
+ * Filas ya generadas de una sala y revision del espacio con la que se generaron.
+ */
+typedef struct _RoomTile
+{
+    Space *space;                          /*!< Espacio pintado, NULL si la entrada esta libre */
+    long revision;                         /*!< Revision del espacio al generar las filas */
+    Player *player;                        /*!< Jugador pintado en la sala activa */
+    char rows[TILE_ROWS][TILE_WIDTH + 1]; /*!< Filas de la sala */
+} RoomTile;
 
 struct _Graphic_engine
 {
+    ScreenBuffer *buffer; /*!< Pantalla en memoria, NULL si se pinta en el terminal */
+    const char *footer;   /*!< Linea que sigue al ultimo fotograma */
     Area *map, *descript, *banner, *help, *feedback;
+    AreaText shown_map, shown_descript, shown_banner, shown_help; /*!< Ultimo contenido pintado de cada area */
+    AreaText next;                                                /*!< Contenido del fotograma en construccion */
+    IdMap *tile_index;                                            /*!< Posicion en tiles de cada espacio */
+    RoomTile *tiles;                                              /*!< N_TILE_KINDS salas por espacio */
+    int n_tiles, tiles_capacity;                                  /*!< Espacios guardados y hueco reservado */
 };
 
-void graphic_engine_paint_spaces_row(Area *area, Game *game, Space *middle, BOOL is_act);
+Graphic_engine *graphic_engine_init(ScreenBuffer *buffer);
+Area *graphic_engine_area_init(Graphic_engine *ge, int x, int y, int width, int height);
+void graphic_engine_text_reset(AreaText *text);
+void graphic_engine_text_puts(AreaText *text, char *str);
+BOOL graphic_engine_flush_area(Area *area, AreaText *next, AreaText *shown);
+void graphic_engine_render_tile(Game *game, Space *space, TileKind kind, RoomTile *tile);
+RoomTile *graphic_engine_get_tile(Graphic_engine *ge, Game *game, Space *space, TileKind kind);
+void graphic_engine_paint_spaces_row(Graphic_engine *ge, AreaText *text, Game *game, Space *middle, BOOL is_act);
 Status graphic_engine_get_objects_str(Game *game, Space *space, char *str);
 void graphic_engine_get_vertical_exits_str(Game *game, Space *space, char *str);
 
 Graphic_engine *graphic_engine_create()
 {
-    static Graphic_engine *ge = NULL;
+    /* Inicializacion del entorno de pantalla fisica */
+    screen_init(SCREEN_ROWS, SCREEN_COLUMNS);
+    return graphic_engine_init(NULL);
+}
+
+Graphic_engine *graphic_engine_create_buffer()
+{
+    ScreenBuffer *buffer = NULL;
+    Graphic_engine *ge = NULL;
 
-    /* Comprueba si el motor grafico ya ha sido instanciado */
-    if (ge)
+    buffer = screen_buffer_create(SCREEN_ROWS, SCREEN_COLUMNS);
+    if (buffer == NULL)
     {
-        return ge;
+        return NULL;
     }
 
-    /* Inicializacion del entorno de pantalla fisica */
-    screen_init(HEIGHT_MAP + HEIGHT_BAN + HEIGHT_HLP + HEIGHT_FDB + 4, WIDTH_MAP + WIDTH_DES + 3);
+    ge = graphic_engine_init(buffer);
+    if (ge == NULL)
+    {
+        screen_buffer_destroy(buffer);
+    }
+    return ge;
+}
+
+Graphic_engine *graphic_engine_init(ScreenBuffer *buffer)
+{
+    Graphic_engine *ge = NULL;
+
     ge = (Graphic_engine *)calloc(1, sizeof(Graphic_engine));
 
     /* Comprueba si la reserva de memoria falla */
@@ -58,88 +134,98 @@ Graphic_engine *graphic_engine_create()
     {
         return NULL;
     }
+    ge->buffer = buffer;
+    ge->footer = "";
+    ge->tile_index = id_map_create(0);
+
+    /* Ningun area pintada todavia: el primer fotograma las pinta todas */
+    ge->shown_map.len = ge->shown_descript.len = ge->shown_banner.len = ge->shown_help.len = -1;
 
     /* Delimitacion de las sub-areas de la interfaz grafica */
-    ge->map = screen_area_init(1, 1, WIDTH_MAP, HEIGHT_MAP);
-    ge->descript = screen_area_init(WIDTH_MAP + 2, 1, WIDTH_DES, HEIGHT_MAP);
-    ge->banner = screen_area_init((int)((WIDTH_MAP + WIDTH_DES + 1 - WIDTH_BAN) / 2), HEIGHT_MAP + 2, WIDTH_BAN, HEIGHT_BAN);
-    ge->help = screen_area_init(1, HEIGHT_MAP + HEIGHT_BAN + 2, WIDTH_MAP + WIDTH_DES + 1, HEIGHT_HLP);
-    ge->feedback = screen_area_init(1, HEIGHT_MAP + HEIGHT_BAN + HEIGHT_HLP + 3, WIDTH_MAP + WIDTH_DES + 1, HEIGHT_FDB);
+    ge->map = graphic_engine_area_init(ge, 1, 1, WIDTH_MAP, HEIGHT_MAP);
+    ge->descript = graphic_engine_area_init(ge, WIDTH_MAP + 2, 1, WIDTH_DES, HEIGHT_MAP);
+    ge->banner = graphic_engine_area_init(ge, (int)((WIDTH_MAP + WIDTH_DES + 1 - WIDTH_BAN) / 2), HEIGHT_MAP + 2, WIDTH_BAN, HEIGHT_BAN);
+    ge->help = graphic_engine_area_init(ge, 1, HEIGHT_MAP + HEIGHT_BAN + 2, WIDTH_MAP + WIDTH_DES + 1, HEIGHT_HLP);
+    ge->feedback = graphic_engine_area_init(ge, 1, HEIGHT_MAP + HEIGHT_BAN + HEIGHT_HLP + 3, WIDTH_MAP + WIDTH_DES + 1, HEIGHT_FDB);
 
     return ge;
 }
 
-void graphic_engine_paint_spaces_row(Area *area, Game *game, Space *middle, BOOL is_act)
+Area *graphic_engine_area_init(Graphic_engine *ge, int x, int y, int width, int height)
 {
-    Space *west, *east;
-    Character *character;
-    char str[255], west_str[85], middle_str[85], east_str[85], obj_list[ROOM_WIDTH + 1];
-    char vertical_exits[3];
-    const char *character_gdesc;
-    char (*space_gdesc)[GDESC_COLS];
-    int i;
-    Status obj_list_status;
-    BOOL west_discovered = FALSE, east_discovered = FALSE, middle_discovered = FALSE;
-
-    /* Comprueba la validez de los argumentos base */
-    if (!area || !middle)
+    /* Las areas se crean en la pantalla en memoria o, si no hay, en el terminal */
+    if (ge->buffer != NULL)
     {
-        return;
+        return screen_buffer_area_init(ge->buffer, x, y, width, height);
     }
+    return screen_area_init(x, y, width, height);
+}
 
-    /* Recoleccion de referencias de los espacios adyacentes */
-    west = game_get_space(game, game_get_connection(game, space_get_id(middle), W));
-    east = game_get_space(game, game_get_connection(game, space_get_id(middle), E));
-    middle_discovered = space_get_discovered(middle);
+void graphic_engine_text_reset(AreaText *text)
+{
+    text->len = 0;
+    text->text[0] = '\0';
+}
 
-    /* Generacion grafica del borde superior */
-    if (!west)
-    {
-        sprintf(west_str, "                     ");
-    }
-    else
+void graphic_engine_text_puts(AreaText *text, char *str)
+{
+    int len;
+
+    /* Lo que no cabe se descarta: el area visible es mucho menor que el buffer */
+    len = (int)strlen(str);
+    if (text->len < 0 || text->len + len + 1 >= AREA_TEXT)
     {
-        sprintf(west_str, "+-------------------+");
+        return;
     }
 
-    if (!east)
+    memcpy(text->text + text->len, str, len);
+    text->len += len;
+    text->text[text->len++] = '\n';
+    text->text[text->len] = '\0';
+}
+
+BOOL graphic_engine_flush_area(Area *area, AreaText *next, AreaText *shown)
+{
+    char *line = NULL, *end = NULL;
+
+    /* Area sin cambios desde el ultimo fotograma: no se toca */
+    if (next->len == shown->len && memcmp(next->text, shown->text, next->len) == 0)
     {
-        sprintf(east_str, "                     ");
+        return FALSE;
     }
-    else
+
+    memcpy(shown->text, next->text, next->len + 1);
+    shown->len = next->len;
+
+    /* Se repinta entera: libscreen no permite cambiar solo unas lineas */
+    screen_area_clear(area);
+    for (line = next->text; *line != '\0'; line = end + 1)
     {
-        sprintf(east_str, "+-------------------+");
+        end = strchr(line, '\n');
+        *end = '\0';
+        screen_area_puts(area, line);
     }
+    return TRUE;
+}
 
-    sprintf(str, "%s  +-------------------+  %s", west_str, east_str);
-    screen_area_puts(area, str);
+void graphic_engine_render_tile(Game *game, Space *space, TileKind kind, RoomTile *tile)
+{
+    Character *character;
+    char obj_list[ROOM_WIDTH + 1];
+    char vertical_exits[3];
+    const char *character_gdesc;
+    char(*space_gdesc)[GDESC_COLS];
+    const char *left, *right;
+    BOOL discovered;
+    int i;
 
-    /* Construccion del bloque de informacion de personajes e identificadores */
-    if (!west)
-    {
-        sprintf(west_str, "                     ");
-    }
-    else if (!(west_discovered = space_get_discovered(west)))
-    {
-        graphic_engine_get_vertical_exits_str(game, west, vertical_exits);
-        sprintf(west_str, "|%s              %3d|", vertical_exits, (int)space_get_id(west));
-    }
-    else
-    {
-        graphic_engine_get_vertical_exits_str(game, west, vertical_exits);
-        character = game_get_character(game, space_get_character(west, 0));
-        if (!character)
-        {
-            character_gdesc = "      ";
-        }
-        else
-        {
-            character_gdesc = character_get_gdesc(character);
-        }
-        sprintf(west_str, "|%s   %s %7d|", vertical_exits, character_gdesc, (int)space_get_id(west));
-    }
+    /* Las salas laterales ocupan 21 columnas; la central lleva dos mas a cada lado */
+    left = (kind == TILE_SIDE) ? "" : "  ";
+    right = left;
+    discovered = space_get_discovered(space);
+    graphic_engine_get_vertical_exits_str(game, space, vertical_exits);
 
-    character = game_get_character(game, space_get_character(middle, 0));
+    character = game_get_character(game, space_get_character(space, 0));
     if (!character)
     {
         character_gdesc = "      ";
@@ -149,194 +235,134 @@ void graphic_engine_paint_spaces_row(Area *area, Game *game, Space *middle, BOOL
         character_gdesc = character_get_gdesc(character);
     }
 
-    if (middle_discovered)
-    {
-        graphic_engine_get_vertical_exits_str(game, middle, vertical_exits);
-        sprintf(middle_str, "  |%s %s %s %5d|  ", vertical_exits, is_act == TRUE ? player_get_gdesc(game_get_player(game)) : "   ", character_gdesc, (int)space_get_id(middle));
-    }
-    else
-    {
-        graphic_engine_get_vertical_exits_str(game, middle, vertical_exits);
-        sprintf(middle_str, "  |%s              %3d|  ", vertical_exits, (int)space_get_id(middle));
-    }
-
-    if (!east)
-    {
-        sprintf(east_str, "                     ");
-    }
-    else if (!(east_discovered = space_get_discovered(east)))
-    {
-        graphic_engine_get_vertical_exits_str(game, east, vertical_exits);
-        sprintf(east_str, "|%s              %3d|", vertical_exits, (int)space_get_id(east));
-    }
-    else
-    {
-        graphic_engine_get_vertical_exits_str(game, east, vertical_exits);
-        character = game_get_character(game, space_get_character(east, 0));
-        if (!character)
-        {
-            character_gdesc = "      ";
-        }
-        else
-        {
-            character_gdesc = character_get_gdesc(character);
-        }
-        sprintf(east_str, "|%s   %s %7d|", vertical_exits, character_gdesc, (int)space_get_id(east));
-    }
-
-    sprintf(str, "%s%s%s", west_str, middle_str, east_str);
-    screen_area_puts(area, str);
-
-    /* Generacion de la representacion visual interior (gdesc) */
-    for (i = 0; i < GDESC_ROWS; i++)
-    {
-        if (!west)
-        {
-            sprintf(west_str, "                     ");
-        }
-        else if (!(west_discovered))
-        {
-            sprintf(west_str, "|                   |");
-        }
-        else
-        {
-            space_gdesc = space_get_gdesc(west);
-            if (!space_gdesc)
-            {
-                sprintf(west_str, "|                   |");
-            }
-            else
-            {
-                sprintf(west_str, "|%s      |", space_gdesc[i]);
-            }
-        }
-
-        space_gdesc = space_get_gdesc(middle);
-        if (middle_discovered)
-        {
-            if (!space_gdesc)
-            {
-                sprintf(middle_str, "  |                   |  ");
-            }
-            else
-            {
-                sprintf(middle_str, "  |%s      |  ", space_gdesc[i]);
-            }
-        }
-        else
-        {
-            sprintf(middle_str, "  |                   |  ");
-        }
-
-        if (!east)
-        {
-            sprintf(east_str, "                     ");
-        }
-        else if (!(east_discovered))
-        {
-            sprintf(east_str, "|                   |");
-        }
-        else
-        {
-            space_gdesc = space_get_gdesc(east);
-            if (!space_gdesc)
-            {
-                sprintf(east_str, "|                   |");
-            }
-            else
-            {
-                sprintf(east_str, "|%s      |", space_gdesc[i]);
-            }
-        }
-
-        sprintf(str, "%s%s%s", west_str, middle_str, east_str);
-        screen_area_puts(area, str);
-    }
+    /* Bordes superior e inferior; las descripciones se recortan a su hueco en la sala */
+    snprintf(tile->rows[0], sizeof(tile->rows[0]), "%s+-------------------+%s", left, right);
+    snprintf(tile->rows[TILE_ROWS - 1], sizeof(tile->rows[0]), "%s+-------------------+%s", left, right);
 
-    /* Evaluacion y renderizado de los objetos presentes en cada espacio */
-    if (!west)
+    /* Cabecera con salidas verticales, personajes e identificador */
+    if (!discovered)
     {
-        sprintf(west_str, "                     ");
+        snprintf(tile->rows[1], sizeof(tile->rows[0]), "%s|%s              %3d|%s", left, vertical_exits, (int)space_get_id(space), right);
     }
-    else if (!(west_discovered))
+    else if (kind == TILE_SIDE)
     {
-        sprintf(west_str, "|                   |");
+        snprintf(tile->rows[1], sizeof(tile->rows[0]), "|%s   %.6s %7d|", vertical_exits, character_gdesc, (int)space_get_id(space));
     }
     else
     {
-        obj_list_status = graphic_engine_get_objects_str(game, west, obj_list);
-        if (obj_list_status == ERROR)
-        {
-            sprintf(west_str, "|                   |");
-        }
-        else
-        {
-            sprintf(west_str, "|%s|", obj_list);
-        }
+        snprintf(tile->rows[1], sizeof(tile->rows[0]), "  |%s %.3s %.6s %5d|  ", vertical_exits, kind == TILE_ACTIVE ? player_get_gdesc(game_get_player(game)) : "   ", character_gdesc, (int)space_get_id(space));
     }
 
-    if (middle_discovered)
+    /* Representacion visual interior (gdesc) */
+    space_gdesc = space_get_gdesc(space);
+    for (i = 0; i < GDESC_ROWS; i++)
     {
-        obj_list_status = graphic_engine_get_objects_str(game, middle, obj_list);
-        if (obj_list_status == ERROR)
+        if (!discovered || !space_gdesc)
         {
-            sprintf(middle_str, " %s|                   |%s ", (west) ? "<" : " ", (east) ? ">" : " ");
+            snprintf(tile->rows[i + 2], sizeof(tile->rows[0]), "%s|                   |%s", left, right);
         }
         else
         {
-            sprintf(middle_str, " %s|%s|%s ", (west) ? "<" : " ", obj_list, (east) ? ">" : " ");
+            snprintf(tile->rows[i + 2], sizeof(tile->rows[0]), "%s|%.13s      |%s", left, space_gdesc[i], right);
         }
     }
-    else
-    {
-        sprintf(middle_str, "  |                   |  ");
-    }
 
-    if (!east)
+    /* Objetos presentes; la sala central marca ademas si hay salas al oeste y al este */
+    if (kind != TILE_SIDE && discovered)
     {
-        sprintf(east_str, "                     ");
+        left = game_get_space(game, game_get_connection(game, space_get_id(space), W)) ? " <" : "  ";
+        right = game_get_space(game, game_get_connection(game, space_get_id(space), E)) ? "> " : "  ";
     }
-    else if (!(east_discovered))
+    if (!discovered || graphic_engine_get_objects_str(game, space, obj_list) == ERROR)
     {
-        sprintf(east_str, "|                   |");
+        snprintf(tile->rows[GDESC_ROWS + 2], sizeof(tile->rows[0]), "%s|                   |%s", left, right);
     }
     else
     {
-        obj_list_status = graphic_engine_get_objects_str(game, east, obj_list);
-        if (obj_list_status == ERROR)
+        snprintf(tile->rows[GDESC_ROWS + 2], sizeof(tile->rows[0]), "%s|%.19s|%s", left, obj_list, right);
+    }
+}
+
+RoomTile *graphic_engine_get_tile(Graphic_engine *ge, Game *game, Space *space, TileKind kind)
+{
+    RoomTile *tiles = NULL, *tile = NULL;
+    Player *player = NULL;
+    int pos, i;
+
+    pos = id_map_get(ge->tile_index, space_get_id(space));
+    if (pos == ID_MAP_NOT_FOUND)
+    {
+        /* Primera vez que se pinta el espacio: se le reservan sus entradas */
+        if (ge->n_tiles == ge->tiles_capacity)
         {
-            sprintf(east_str, "|                   |");
+            tiles = (RoomTile *)realloc(ge->tiles, (ge->tiles_capacity ? 2 * ge->tiles_capacity : MIN_TILES) * N_TILE_KINDS * sizeof(RoomTile));
+            if (!tiles)
+            {
+                return NULL;
+            }
+            ge->tiles = tiles;
+            ge->tiles_capacity = ge->tiles_capacity ? 2 * ge->tiles_capacity : MIN_TILES;
         }
-        else
+        if (id_map_put(ge->tile_index, space_get_id(space), ge->n_tiles) == ERROR)
+        {
+            return NULL;
+        }
+        pos = ge->n_tiles++;
+        for (i = 0; i < N_TILE_KINDS; i++)
         {
-            sprintf(east_str, "|%s|", obj_list);
+            ge->tiles[pos * N_TILE_KINDS + i].space = NULL;
         }
     }
 
-    sprintf(str, "%s%s%s", west_str, middle_str, east_str);
-    screen_area_puts(area, str);
-
-    /* Construccion grafica del borde inferior de cierre */
-    if (!west)
+    /* Solo se vuelve a generar si el espacio ha cambiado desde que se pinto */
+    tile = &ge->tiles[pos * N_TILE_KINDS + kind];
+    player = (kind == TILE_ACTIVE) ? game_get_player(game) : NULL;
+    if (tile->space != space || tile->revision != space_get_revision(space) || tile->player != player)
     {
-        sprintf(west_str, "                     ");
+        graphic_engine_render_tile(game, space, kind, tile);
+        tile->space = space;
+        tile->revision = space_get_revision(space);
+        tile->player = player;
     }
-    else
+
+    return tile;
+}
+
+void graphic_engine_paint_spaces_row(Graphic_engine *ge, AreaText *text, Game *game, Space *middle, BOOL is_act)
+{
+    RoomTile *west = NULL, *center = NULL, *east = NULL;
+    Space *west_space = NULL, *east_space = NULL;
+    char str[255];
+    int i;
+
+    /* Comprueba la validez de los argumentos base */
+    if (!ge || !text || !middle)
     {
-        sprintf(west_str, "+-------------------+");
+        return;
     }
 
-    if (!east)
+    /* Salas ya generadas del espacio y de sus vecinos al oeste y al este */
+    center = graphic_engine_get_tile(ge, game, middle, is_act == TRUE ? TILE_ACTIVE : TILE_MIDDLE);
+    if (!center)
     {
-        sprintf(east_str, "                     ");
+        return;
     }
-    else
+    west_space = game_get_space(game, game_get_connection(game, space_get_id(middle), W));
+    if (west_space)
     {
-        sprintf(east_str, "+-------------------+");
+        west = graphic_engine_get_tile(ge, game, west_space, TILE_SIDE);
+    }
+    east_space = game_get_space(game, game_get_connection(game, space_get_id(middle), E));
+    if (east_space)
+    {
+        east = graphic_engine_get_tile(ge, game, east_space, TILE_SIDE);
     }
 
-    sprintf(str, "%s  +-------------------+  %s", west_str, east_str);
-    screen_area_puts(area, str);
+    for (i = 0; i < TILE_ROWS; i++)
+    {
+        sprintf(str, "%s%s%s", west ? west->rows[i] : SIDE_BLANK, center->rows[i], east ? east->rows[i] : SIDE_BLANK);
+        graphic_engine_text_puts(text, str);
+    }
 }
 
 Status graphic_engine_get_objects_str(Game *game, Space *space, char *str)
@@ -386,6 +412,20 @@ Status graphic_engine_get_objects_str(Game *game, Space *space, char *str)
     return OK;
 }
 
+void graphic_engine_reset(Graphic_engine *ge)
+{
+    /* Comprueba la validez del motor grafico */
+    if (!ge)
+    {
+        return;
+    }
+
+    /* Las salas guardadas solo valen para la partida con la que se pintaron */
+    id_map_destroy(ge->tile_index);
+    ge->tile_index = id_map_create(0);
+    ge->n_tiles = 0;
+}
+
 void graphic_engine_destroy(Graphic_engine *ge)
 {
     /* Comprueba la validez del motor grafico */
@@ -401,23 +441,59 @@ void graphic_engine_destroy(Graphic_engine *ge)
     screen_area_destroy(ge->help);
     screen_area_destroy(ge->feedback);
 
-    screen_destroy();
+    id_map_destroy(ge->tile_index);
+    free(ge->tiles);
+
+    if (ge->buffer != NULL)
+    {
+        screen_buffer_destroy(ge->buffer);
+    }
+    else
+    {
+        screen_destroy();
+    }
     free(ge);
 }
 
+int graphic_engine_get_frame_size()
+{
+    /* Filas con su '\n', la linea final mas larga y el '\0' */
+    return SCREEN_ROWS * (SCREEN_COLUMNS + 1) + FOOTER_MAX + 1;
+}
+
+int graphic_engine_render(Graphic_engine *ge, char *buf, int size)
+{
+    int len;
+
+    /* Solo el motor en memoria conserva el fotograma como texto */
+    if (!ge || !ge->buffer || !buf)
+    {
+        return -1;
+    }
+
+    len = screen_buffer_render(ge->buffer, buf, size);
+    if (len < 0 || len + (int)strlen(ge->footer) + 1 > size)
+    {
+        return -1;
+    }
+
+    strcpy(buf + len, ge->footer);
+    return len + (int)strlen(ge->footer);
+}
+
 void graphic_engine_paint_game(Graphic_engine *ge, Game *game, Status last_cmd_status, BOOL paint_cmd)
 {
     Id id_act = NO_ID, id_back = NO_ID, id_top = NO_ID, id_next = NO_ID, obj_loc = NO_ID, object_in_backpack = NO_ID;
     Space *act = NULL;
     char str[255];
     CommandCode last_cmd = UNKNOWN;
-    extern char *cmd_to_str[N_CMD][N_CMDT];
     int i;
     Player *player = NULL;
     Character *character = NULL;
     Object *obj = NULL;
     int obj_found = 0;
     int max_backpack_obj = 0;
+    BOOL dirty = FALSE;
 
     /* Comprueba la validez del juego */
     if (!game)
@@ -426,7 +502,7 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game, Status last_cmd_s
     }
 
     /* Procedimiento de actualizacion de la capa visual del mapa */
-    screen_area_clear(ge->map);
+    graphic_engine_text_reset(&ge->next);
     if ((id_act = game_get_player_location(game)) != NO_ID)
     {
         act = game_get_space(game, id_act);
@@ -439,67 +515,62 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game, Status last_cmd_s
             id_top = game_get_connection(game, id_back, N);
             if (id_top != NO_ID)
             {
-                graphic_engine_paint_spaces_row(ge->map, game, game_get_space(game, id_top), FALSE);
-                screen_area_puts(ge->map, " ");
+                graphic_engine_paint_spaces_row(ge, &ge->next, game, game_get_space(game, id_top), FALSE);
+                graphic_engine_text_puts(&ge->next, " ");
             }
         }
 
         if (id_back != NO_ID)
         {
-            graphic_engine_paint_spaces_row(ge->map, game, game_get_space(game, id_back), FALSE);
-            screen_area_puts(ge->map, "                                 ^");
+            graphic_engine_paint_spaces_row(ge, &ge->next, game, game_get_space(game, id_back), FALSE);
+            graphic_engine_text_puts(&ge->next, "                                 ^");
         }
 
-        graphic_engine_paint_spaces_row(ge->map, game, act, TRUE);
+        graphic_engine_paint_spaces_row(ge, &ge->next, game, act, TRUE);
 
         /* Renderizado direccional Sur */
         if (id_next != NO_ID)
         {
-            screen_area_puts(ge->map, "                                 v");
-            graphic_engine_paint_spaces_row(ge->map, game, game_get_space(game, id_next), FALSE);
+            graphic_engine_text_puts(&ge->next, "                                 v");
+            graphic_engine_paint_spaces_row(ge, &ge->next, game, game_get_space(game, id_next), FALSE);
         }
     }
 
+    dirty = graphic_engine_flush_area(ge->map, &ge->next, &ge->shown_map) || dirty;
+
     /* Procedimiento de actualizacion del panel de descripcion */
-    screen_area_clear(ge->descript);
+    graphic_engine_text_reset(&ge->next);
 
     /* Renderizado de ubicaciones de objetos globales */
-    screen_area_puts(ge->descript, " Objects:");
-    for (i = 0; i < MAX_OBJECTS; i++)
+    graphic_engine_text_puts(&ge->next, " Objects:");
+    for (i = 0; i < game_get_number_of_objects(game); i++)
     {
-        obj = game_get_object(game, i);
-        if (obj)
+        /* La ubicacion sale de la columna del juego; el objeto solo se lee si se muestra */
+        obj_loc = game_get_object_location_at(game, i);
+        if (obj_loc != NO_ID && (obj = game_get_object_from_index(game, i)) != NULL)
         {
-            obj_loc = game_get_object_location(game, i);
-            if (obj_loc != NO_ID)
-            {
-                sprintf(str, "  %-10s: %d", object_get_name(obj), (int)obj_loc);
-                screen_area_puts(ge->descript, str);
-            }
+            sprintf(str, "  %-10s: %d", object_get_name(obj), (int)obj_loc);
+            graphic_engine_text_puts(&ge->next, str);
         }
     }
 
     /* Renderizado del estado y ubicacion de los personajes */
-    screen_area_puts(ge->descript, " Characters:");
-    for (i = 0; i < MAX_CHARACTERS; i++)
+    graphic_engine_text_puts(&ge->next, " Characters:");
+    for (i = 0; i < game_get_number_of_characters(game); i++)
     {
-        character = game_get_character_at(game, i);
-        if (character)
+        Id char_loc = game_get_character_location_at(game, i);
+        if (char_loc != NO_ID && (character = game_get_character_at(game, i)) != NULL)
         {
-            Id char_loc = game_get_character_location(game, character_get_id(character));
-            if (char_loc != NO_ID)
+            int health = game_get_character_health_at(game, i);
+            if (health > 0)
             {
-                int health = character_get_health(character);
-                if (health > 0)
-                {
-                    sprintf(str, "  %-10s: %d (%d)", character_get_name(character), (int)char_loc, health);
-                }
-                else
-                {
-                    sprintf(str, "  %-10s: %d (DEAD)", character_get_name(character), (int)char_loc);
-                }
-                screen_area_puts(ge->descript, str);
+                sprintf(str, "  %-10s: %d (%d)", character_get_name(character), (int)char_loc, health);
             }
+            else
+            {
+                sprintf(str, "  %-10s: %d (DEAD)", character_get_name(character), (int)char_loc);
+            }
+            graphic_engine_text_puts(&ge->next, str);
         }
     }
 
@@ -507,9 +578,9 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game, Status last_cmd_s
     player = game_get_player(game);
     max_backpack_obj = inventory_get_max_objs(player_get_backpack(player));
     sprintf(str, " Player: %d (%d)", (int)player_get_location(player), player_get_health(player));
-    screen_area_puts(ge->descript, str);
+    graphic_engine_text_puts(&ge->next, str);
 
-    screen_area_puts(ge->descript, "Player has: ");
+    graphic_engine_text_puts(&ge->next, "Player has: ");
     for (i = 0; i < max_backpack_obj; i++)
     {
         object_in_backpack = player_get_object(player, i);
@@ -524,66 +595,87 @@ void graphic_engine_paint_game(Graphic_engine *ge, Game *game, Status last_cmd_s
             {
                 sprintf(str, "  - Unknown");
             }
-            screen_area_puts(ge->descript, str);
+            graphic_engine_text_puts(&ge->next, str);
             obj_found++;
         }
     }
 
     if (obj_found == 0)
     {
-        screen_area_puts(ge->descript, "no objects");
+        graphic_engine_text_puts(&ge->next, "no objects");
     }
 
     /* Renderizado del sistema de dialogos e inspeccion */
-    screen_area_puts(ge->descript, " ");
-    screen_area_puts(ge->descript, game_get_chat_message(game));
+    graphic_engine_text_puts(&ge->next, " ");
+    graphic_engine_text_puts(&ge->next, game_get_chat_message(game));
     game_set_chat_message(game, "");
 
-    screen_area_puts(ge->descript, " ");
+    graphic_engine_text_puts(&ge->next, " ");
     if (game_get_object_desc(game) != NULL)
     {
         if (strlen(game_get_object_desc(game)) > 0)
         {
             sprintf(str, "Item description: %s", game_get_object_desc(game));
-            screen_area_puts(ge->descript, str);
+            graphic_engine_text_puts(&ge->next, str);
             game_set_object_desc(game, "");
         }
     }
 
+    dirty = graphic_engine_flush_area(ge->descript, &ge->next, &ge->shown_descript) || dirty;
+
     /* Actualizacion de modulos auxiliares: Banner, Help y Feedback */
+    graphic_engine_text_reset(&ge->next);
     sprintf(str, "  Turn Player :%d ", game_get_turn(game) + 1);
-    screen_area_puts(ge->banner, str);
+    graphic_engine_text_puts(&ge->next, str);
+    dirty = graphic_engine_flush_area(ge->banner, &ge->next, &ge->shown_banner) || dirty;
 
-    screen_area_clear(ge->help);
-    screen_area_puts(ge->help, " The commands you can use are:");
-    screen_area_puts(ge->help, "     exit/e, take/t, drop/d, attack/a, chat/c, move/m");
-    screen_area_puts(ge->help, "     inspect/i, recruit/r, abandon/ab, open/o");
-    screen_area_puts(ge->help, "     move: north/south/east/west/up/down; U/D marks up/down exits");
+    graphic_engine_text_reset(&ge->next);
+    graphic_engine_text_puts(&ge->next, " The commands you can use are:");
+    graphic_engine_text_puts(&ge->next, "     exit/e, take/t, drop/d, attack/a, chat/c, move/m");
+    graphic_engine_text_puts(&ge->next, "     inspect/i, recruit/r, abandon/ab, open/o");
+    graphic_engine_text_puts(&ge->next, "     move: north/south/east/west/up/down; U/D marks up/down exits");
 
+    dirty = graphic_engine_flush_area(ge->help, &ge->next, &ge->shown_help) || dirty;
+
+    /* El feedback es un historial: cada comando anade una linea */
     if (paint_cmd == TRUE)
     {
         last_cmd = command_get_code(game_get_last_command(game));
         if (last_cmd_status == OK)
         {
-            sprintf(str, " %s (%s): OK", cmd_to_str[last_cmd - NO_CMD][CMDL], cmd_to_str[last_cmd - NO_CMD][CMDS]);
+            sprintf(str, " %s (%s): OK", command_code_to_str(last_cmd, CMDL), command_code_to_str(last_cmd, CMDS));
         }
         else
         {
-            sprintf(str, " %s (%s): ERROR", cmd_to_str[last_cmd - NO_CMD][CMDL], cmd_to_str[last_cmd - NO_CMD][CMDS]);
+            sprintf(str, " %s (%s): ERROR", command_code_to_str(last_cmd, CMDL), command_code_to_str(last_cmd, CMDS));
         }
         screen_area_puts(ge->feedback, str);
+        dirty = TRUE;
     }
 
-    /* Refresco por pantalla del ciclo completo */
-    screen_paint(game_get_turn(game));
-
     if (game_get_finished(game)) {
-        printf("GAME OVER\n");
+        ge->footer = "GAME OVER\n";
     } else if (command_get_code(game_get_last_command(game)) == EXIT) {
-        printf("GAME EXIT\n");
+        ge->footer = "GAME EXIT\n";
     } else {
-        printf("prompt:> ");
+        ge->footer = "prompt:> ";
+    }
+
+    /* En memoria el fotograma queda compuesto; se recoge con graphic_engine_render */
+    if (ge->buffer != NULL)
+    {
+        return;
+    }
+
+    /* Sin cambios desde el ultimo fotograma no se vuelve a volcar la pantalla */
+    if (dirty == FALSE)
+    {
+        return;
     }
+
+    /* Refresco por pantalla del ciclo completo */
+    screen_paint(game_get_turn(game));
+    printf("%s", ge->footer);
 }
 
 void graphic_engine_get_vertical_exits_str(Game *game, Space *space, char *str)
@@ -0,0 +1,249 @@
+/**
+ * @brief Implementa el índice hash de identificadores
+ *
+ * @file id_map.c
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#include "id_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MIN_BUCKETS 16
+#define EMPTY_SLOT -1
+
+/**
+ * @brief IdMap
+ * Tabla hash de direccionamiento abierto (sondeo lineal) que asocia Ids a posiciones.
+ */
+struct _IdMap
+{
+  Id *keys;       /*!< Claves almacenadas en cada cubeta */
+  int *positions; /*!< Posicion asociada a cada clave, EMPTY_SLOT si esta libre */
+  int n_buckets;  /*!< Numero de cubetas (potencia de dos) */
+  int n_elems;    /*!< Numero de claves ocupadas */
+};
+
+int id_map_hash(Id id, int n_buckets);
+Status id_map_resize(IdMap *map, int n_buckets);
+
+int id_map_hash(Id id, int n_buckets)
+{
+  unsigned long h = (unsigned long)id;
+
+  /* Mezcla de bits para repartir Ids consecutivos o con saltos regulares */
+  h ^= h >> 16;
+  h *= 0x45d9f3bUL;
+  h ^= h >> 16;
+
+  return (int)(h & (unsigned long)(n_buckets - 1));
+}
+
+IdMap *id_map_create(int n_elems)
+{
+  IdMap *map = NULL;
+  int n_buckets = MIN_BUCKETS;
+
+  if (n_elems < 0)
+  {
+    return NULL;
+  }
+
+  map = (IdMap *)calloc(1, sizeof(IdMap));
+  /* Comprueba si falla la reserva de memoria */
+  if (map == NULL)
+  {
+    return NULL;
+  }
+
+  /* Se mantiene el factor de carga por debajo de 1/2 */
+  while (n_buckets < 2 * n_elems)
+  {
+    n_buckets *= 2;
+  }
+
+  if (id_map_resize(map, n_buckets) == ERROR)
+  {
+    free(map);
+    return NULL;
+  }
+
+  return map;
+}
+
+Status id_map_destroy(IdMap *map)
+{
+  if (!map)
+  {
+    return ERROR;
+  }
+
+  free(map->keys);
+  free(map->positions);
+  free(map);
+  return OK;
+}
+
+Status id_map_resize(IdMap *map, int n_buckets)
+{
+  Id *old_keys = NULL;
+  int *old_positions = NULL;
+  int old_n_buckets, i, j;
+
+  if (!map || n_buckets <= 0)
+  {
+    return ERROR;
+  }
+
+  old_keys = map->keys;
+  old_positions = map->positions;
+  old_n_buckets = map->n_buckets;
+
+  map->keys = (Id *)malloc(n_buckets * sizeof(Id));
+  map->positions = (int *)malloc(n_buckets * sizeof(int));
+  if (!map->keys || !map->positions)
+  {
+    free(map->keys);
+    free(map->positions);
+    map->keys = old_keys;
+    map->positions = old_positions;
+    return ERROR;
+  }
+
+  for (i = 0; i < n_buckets; i++)
+  {
+    map->keys[i] = NO_ID;
+    map->positions[i] = EMPTY_SLOT;
+  }
+  map->n_buckets = n_buckets;
+
+  /* Reinsercion de las claves de la tabla anterior */
+  for (i = 0; i < old_n_buckets; i++)
+  {
+    if (old_positions[i] != EMPTY_SLOT)
+    {
+      j = id_map_hash(old_keys[i], n_buckets);
+      while (map->positions[j] != EMPTY_SLOT)
+      {
+        j = (j + 1) & (n_buckets - 1);
+      }
+      map->keys[j] = old_keys[i];
+      map->positions[j] = old_positions[i];
+    }
+  }
+
+  free(old_keys);
+  free(old_positions);
+  return OK;
+}
+
+Status id_map_put(IdMap *map, Id id, int position)
+{
+  int i;
+
+  if (!map || id == NO_ID || position < 0)
+  {
+    return ERROR;
+  }
+
+  /* Duplica la tabla antes de superar el factor de carga */
+  if (2 * (map->n_elems + 1) > map->n_buckets)
+  {
+    if (id_map_resize(map, 2 * map->n_buckets) == ERROR)
+    {
+      return ERROR;
+    }
+  }
+
+  i = id_map_hash(id, map->n_buckets);
+  while (map->positions[i] != EMPTY_SLOT && map->keys[i] != id)
+  {
+    i = (i + 1) & (map->n_buckets - 1);
+  }
+
+  if (map->positions[i] == EMPTY_SLOT)
+  {
+    map->keys[i] = id;
+    map->n_elems++;
+  }
+  map->positions[i] = position;
+
+  return OK;
+}
+
+Status id_map_del(IdMap *map, Id id)
+{
+  int i, j, home;
+
+  if (!map || id == NO_ID)
+  {
+    return ERROR;
+  }
+
+  i = id_map_hash(id, map->n_buckets);
+  while (map->positions[i] != EMPTY_SLOT && map->keys[i] != id)
+  {
+    i = (i + 1) & (map->n_buckets - 1);
+  }
+  if (map->positions[i] == EMPTY_SLOT)
+  {
+    return ERROR;
+  }
+
+  /* Desplaza hacia atras las claves del mismo grupo para no dejar huecos */
+  j = i;
+  while (1)
+  {
+    map->positions[i] = EMPTY_SLOT;
+    map->keys[i] = NO_ID;
+    do
+    {
+      j = (j + 1) & (map->n_buckets - 1);
+      if (map->positions[j] == EMPTY_SLOT)
+      {
+        map->n_elems--;
+        return OK;
+      }
+      home = id_map_hash(map->keys[j], map->n_buckets);
+    } while ((i <= j) ? (i < home && home <= j) : (i < home || home <= j));
+
+    map->keys[i] = map->keys[j];
+    map->positions[i] = map->positions[j];
+    i = j;
+  }
+}
+
+int id_map_get(IdMap *map, Id id)
+{
+  int i;
+
+  if (!map || id == NO_ID)
+  {
+    return ID_MAP_NOT_FOUND;
+  }
+
+  /* Sondeo lineal hasta encontrar la clave o una cubeta libre */
+  i = id_map_hash(id, map->n_buckets);
+  while (map->positions[i] != EMPTY_SLOT)
+  {
+    if (map->keys[i] == id)
+    {
+      return map->positions[i];
+    }
+    i = (i + 1) & (map->n_buckets - 1);
+  }
+
+  return ID_MAP_NOT_FOUND;
+}
+
+int id_map_get_n_elems(IdMap *map)
+{
+  if (!map)
+  {
+    return -1;
+  }
+  return map->n_elems;
+}
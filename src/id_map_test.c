@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "id_map.h"
+#include "id_map_test.h"
+#include "test.h"
+#define MAX_TESTS 13
+int main(int argc, char** argv) {
+    int test = 0;
+    if (argc > 1) test = atoi(argv[1]);
+    if (test < 0 || test > MAX_TESTS) {
+        printf("Error: unknown test %d\t", test);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (test == 0 || test == 1) test1_id_map_create();
+    if (test == 0 || test == 2) test2_id_map_create();
+    if (test == 0 || test == 3) test1_id_map_destroy();
+    if (test == 0 || test == 4) test2_id_map_destroy();
+    if (test == 0 || test == 5) test1_id_map_put();
+    if (test == 0 || test == 6) test2_id_map_put();
+    if (test == 0 || test == 7) test1_id_map_get();
+    if (test == 0 || test == 8) test2_id_map_get();
+    if (test == 0 || test == 9) test3_id_map_get();
+    if (test == 0 || test == 10) test1_id_map_del();
+    if (test == 0 || test == 11) test2_id_map_del();
+    if (test == 0 || test == 12) test1_id_map_get_n_elems();
+    if (test == 0 || test == 13) test2_id_map_get_n_elems();
+
+    PRINT_PASSED_PERCENTAGE;
+    return 0;
+}
+
+void test1_id_map_create() {
+    IdMap *m = id_map_create(10);
+    PRINT_TEST_RESULT(m != NULL);
+    id_map_destroy(m);
+}
+
+void test2_id_map_create() {
+    PRINT_TEST_RESULT(id_map_create(-1) == NULL);
+}
+
+void test1_id_map_destroy() {
+    IdMap *m = id_map_create(10);
+    PRINT_TEST_RESULT(id_map_destroy(m) == OK);
+}
+
+void test2_id_map_destroy() {
+    PRINT_TEST_RESULT(id_map_destroy(NULL) == ERROR);
+}
+
+void test1_id_map_put() {
+    IdMap *m = id_map_create(10);
+    PRINT_TEST_RESULT(id_map_put(m, 11, 0) == OK);
+    id_map_destroy(m);
+}
+
+void test2_id_map_put() {
+    IdMap *m = id_map_create(10);
+    PRINT_TEST_RESULT(id_map_put(m, NO_ID, 0) == ERROR);
+    id_map_destroy(m);
+}
+
+void test1_id_map_get() {
+    IdMap *m = id_map_create(10);
+    id_map_put(m, 111, 3);
+    PRINT_TEST_RESULT(id_map_get(m, 111) == 3);
+    id_map_destroy(m);
+}
+
+void test2_id_map_get() {
+    IdMap *m = id_map_create(10);
+    id_map_put(m, 111, 3);
+    PRINT_TEST_RESULT(id_map_get(m, 112) == ID_MAP_NOT_FOUND);
+    id_map_destroy(m);
+}
+
+void test3_id_map_get() {
+    IdMap *m = id_map_create(1);
+    int i, ok = 1;
+    /* Fuerza varias ampliaciones de la tabla */
+    for (i = 0; i < 1000; i++) {
+        id_map_put(m, (Id)(i * 10 + 1), i);
+    }
+    for (i = 0; i < 1000; i++) {
+        if (id_map_get(m, (Id)(i * 10 + 1)) != i) ok = 0;
+    }
+    PRINT_TEST_RESULT(ok);
+    id_map_destroy(m);
+}
+
+void test1_id_map_del() {
+    IdMap *m = id_map_create(1);
+    int i, ok = 1;
+    for (i = 0; i < 200; i++) {
+        id_map_put(m, (Id)i, i);
+    }
+    /* Borra los pares y comprueba que los impares siguen accesibles */
+    for (i = 0; i < 200; i += 2) {
+        id_map_del(m, (Id)i);
+    }
+    for (i = 0; i < 200; i++) {
+        if (id_map_get(m, (Id)i) != ((i % 2) ? i : ID_MAP_NOT_FOUND)) ok = 0;
+    }
+    PRINT_TEST_RESULT(ok && id_map_get_n_elems(m) == 100);
+    id_map_destroy(m);
+}
+
+void test2_id_map_del() {
+    IdMap *m = id_map_create(10);
+    PRINT_TEST_RESULT(id_map_del(m, 5) == ERROR);
+    id_map_destroy(m);
+}
+
+void test1_id_map_get_n_elems() {
+    IdMap *m = id_map_create(10);
+    id_map_put(m, 11, 0);
+    id_map_put(m, 11, 1);
+    id_map_put(m, 12, 2);
+    PRINT_TEST_RESULT(id_map_get_n_elems(m) == 2);
+    id_map_destroy(m);
+}
+
+void test2_id_map_get_n_elems() {
+    PRINT_TEST_RESULT(id_map_get_n_elems(NULL) == -1);
+}
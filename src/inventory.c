@@ -17,9 +17,15 @@ struct _Inventory
 {
   Set *objs;     /*!< Conjunto de objetos almacenados */
   int max_objs;  /*!< Capacidad maxima del inventario */
+  Arena *arena;  /*!< Almacen del que sale la memoria (NULL si es del heap) */
 };
 
 Inventory *inventory_create(int max_objs)
+{
+  return inventory_create_in(NULL, max_objs);
+}
+
+Inventory *inventory_create_in(Arena *arena, int max_objs)
 {
   Inventory *inventory = NULL;
 
@@ -29,21 +35,22 @@ Inventory *inventory_create(int max_objs)
     return NULL;
   }
 
-  inventory = (Inventory *)malloc(sizeof(Inventory));
+  inventory = (Inventory *)arena_alloc(arena, sizeof(Inventory));
   /* Comprueba si la reserva de memoria principal falla */
   if (inventory == NULL)
   {
     return NULL;
   }
 
-  inventory->objs = set_create();
+  inventory->objs = set_create_in(arena);
   /* Comprueba si la reserva del conjunto interno falla */
   if (inventory->objs == NULL)
   {
-    free(inventory);
+    arena_free(arena, inventory);
     return NULL;
   }
 
+  inventory->arena = arena;
   inventory->max_objs = max_objs;
   return inventory;
 }
@@ -58,7 +65,7 @@ Status inventory_destroy(Inventory *inventory)
 
   /* Libera la memoria del conjunto interno y la estructura */
   set_destroy(inventory->objs);
-  free(inventory);
+  arena_free(inventory->arena, inventory);
   return OK;
 }
 
@@ -0,0 +1,427 @@
+/**
+ * @brief Implementa la interfaz de pantalla con secuencias ANSI
+ *
+ * El fotograma se compone en memoria. Cada screen_paint lo compara con lo
+ * que ya muestra el terminal, genera solo las celdas que han cambiado y las
+ * manda con una unica llamada a write. Las pantallas en memoria usan la
+ * misma composicion pero solo se vuelcan como texto a un buffer.
+ *
+ * @file libscreen.c
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "libscreen.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "types.h"
+
+#define BG_CHAR '~'
+#define FG_CHAR ' '
+#define FG_STYLE "\033[0;30;47m"
+#define RESET_STYLE "\033[0m"
+#define CLEAR_SCREEN "\033[2J"
+#define ESCAPE_MAX 32 /* Secuencia de escape mas larga que se genera */
+#define RUN_GAP 4     /* Celdas sin cambios que sale mas barato reescribir que saltar */
+#define SPECIAL_LEAD '\303' /* Primer byte UTF-8 de las vocales acentuadas y la enye */
+#define SPECIAL_CHARS "\201\211\215\223\232\221\241\251\255\263\272\261" /* Segundo byte de cada una */
+
+/**
+ * @brief Area
+ * Rectangulo de la pantalla con su propio cursor de escritura.
+ */
+struct _Area
+{
+  ScreenBuffer *screen; /*!< Pantalla a la que pertenece */
+  int x, y;             /*!< Esquina superior izquierda */
+  int width, height;    /*!< Dimensiones del area */
+  int cursor;           /*!< Fila del area donde escribe el proximo puts */
+};
+
+/**
+ * @brief ScreenBuffer
+ * Fotograma en composicion y, en el terminal, copia de lo que ya muestra.
+ */
+struct _ScreenBuffer
+{
+  int rows, columns; /*!< Dimensiones de la pantalla */
+  char *data;        /*!< Fotograma en composicion */
+  char *shown;       /*!< Contenido actual del terminal, NULL en memoria */
+  int shown_color;   /*!< Color de fondo pintado, -1 si no se ha pintado nada */
+  char *out;         /*!< Bytes del proximo volcado al terminal */
+  size_t out_len;    /*!< Bytes usados de out */
+};
+
+static ScreenBuffer *terminal = NULL;
+
+const char *screen_color_style(Frame_color color);
+char *screen_cell(ScreenBuffer *screen, int x, int y);
+BOOL screen_cell_changed(ScreenBuffer *screen, int i, Frame_color color);
+void screen_out_append(ScreenBuffer *screen, const char *str);
+void screen_out_flush(ScreenBuffer *screen);
+void screen_area_scroll_up(Area *area);
+
+const char *screen_color_style(Frame_color color)
+{
+  switch (color)
+  {
+  case BLACK:
+    return "\033[0;30;40m";
+  case RED:
+    return "\033[0;34;41m";
+  case GREEN:
+    return "\033[0;34;42m";
+  case YELLOW:
+    return "\033[0;34;43m";
+  case BLUE:
+    return "\033[0;34;44m";
+  case PURPLE:
+    return "\033[0;34;45m";
+  case CYAN:
+    return "\033[0;34;46m";
+  case WHITE:
+    return "\033[0;34;47m";
+  }
+  return "\033[0;34;44m";
+}
+
+char *screen_cell(ScreenBuffer *screen, int x, int y)
+{
+  return screen->data + y * screen->columns + x;
+}
+
+BOOL screen_cell_changed(ScreenBuffer *screen, int i, Frame_color color)
+{
+  if (screen->data[i] != screen->shown[i])
+  {
+    return TRUE;
+  }
+  /* El fondo cambia de color aunque el caracter sea el mismo */
+  return (screen->data[i] == BG_CHAR && (int)color != screen->shown_color) ? TRUE : FALSE;
+}
+
+void screen_out_append(ScreenBuffer *screen, const char *str)
+{
+  size_t len = strlen(str);
+
+  memcpy(screen->out + screen->out_len, str, len);
+  screen->out_len += len;
+}
+
+void screen_out_flush(ScreenBuffer *screen)
+{
+  size_t done = 0;
+  ssize_t written;
+
+  /* Lo que el juego haya escrito con printf debe salir antes que el fotograma */
+  fflush(stdout);
+
+  while (done < screen->out_len)
+  {
+    written = write(STDOUT_FILENO, screen->out + done, screen->out_len - done);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      break;
+    }
+    done += (size_t)written;
+  }
+  screen->out_len = 0;
+}
+
+ScreenBuffer *screen_buffer_create(int rows, int columns)
+{
+  ScreenBuffer *screen = NULL;
+
+  if (rows <= 0 || columns <= 0)
+  {
+    return NULL;
+  }
+
+  screen = (ScreenBuffer *)calloc(1, sizeof(ScreenBuffer));
+  if (screen == NULL)
+  {
+    return NULL;
+  }
+
+  screen->data = (char *)malloc((size_t)rows * (size_t)columns);
+  if (screen->data == NULL)
+  {
+    free(screen);
+    return NULL;
+  }
+
+  screen->rows = rows;
+  screen->columns = columns;
+  screen->shown_color = -1;
+  memset(screen->data, BG_CHAR, (size_t)rows * (size_t)columns);
+
+  return screen;
+}
+
+void screen_buffer_destroy(ScreenBuffer *screen)
+{
+  if (!screen)
+  {
+    return;
+  }
+
+  free(screen->data);
+  free(screen->shown);
+  free(screen->out);
+  free(screen);
+}
+
+Area *screen_buffer_area_init(ScreenBuffer *screen, int x, int y, int width, int height)
+{
+  Area *area = NULL;
+  int i;
+
+  /* El area tiene que caber entera en la pantalla */
+  if (!screen || x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > screen->columns || y + height > screen->rows)
+  {
+    return NULL;
+  }
+
+  area = (Area *)malloc(sizeof(Area));
+  if (area == NULL)
+  {
+    return NULL;
+  }
+
+  area->screen = screen;
+  area->x = x;
+  area->y = y;
+  area->width = width;
+  area->height = height;
+  area->cursor = 0;
+
+  for (i = 0; i < height; i++)
+  {
+    memset(screen_cell(screen, x, y + i), FG_CHAR, width);
+  }
+
+  return area;
+}
+
+int screen_buffer_render(ScreenBuffer *screen, char *buf, int size)
+{
+  int r, len;
+
+  if (!screen || !buf)
+  {
+    return -1;
+  }
+
+  /* Cada fila acaba en '\n' y el texto completo en '\0' */
+  len = screen->rows * (screen->columns + 1);
+  if (size < len + 1)
+  {
+    return -1;
+  }
+
+  for (r = 0; r < screen->rows; r++)
+  {
+    memcpy(buf + r * (screen->columns + 1), screen_cell(screen, 0, r), screen->columns);
+    buf[r * (screen->columns + 1) + screen->columns] = '\n';
+  }
+  buf[len] = '\0';
+
+  return len;
+}
+
+void screen_init(int rows, int columns)
+{
+  size_t cells;
+
+  screen_destroy();
+  terminal = screen_buffer_create(rows, columns);
+  if (terminal == NULL)
+  {
+    return;
+  }
+
+  /* Peor caso: un cambio de estilo y un salto de cursor por celda */
+  cells = (size_t)rows * (size_t)columns;
+  terminal->shown = (char *)malloc(cells);
+  terminal->out = (char *)malloc(cells * (2 * ESCAPE_MAX + 1) + 4 * ESCAPE_MAX);
+  if (!terminal->shown || !terminal->out)
+  {
+    screen_destroy();
+  }
+}
+
+void screen_destroy()
+{
+  screen_buffer_destroy(terminal);
+  terminal = NULL;
+}
+
+void screen_paint(Frame_color color)
+{
+  ScreenBuffer *screen = terminal;
+  char escape[ESCAPE_MAX];
+  const char *bg_style = screen_color_style(color), *style = NULL, *next_style = NULL;
+  int r, c, i, gap;
+
+  if (!screen)
+  {
+    return;
+  }
+
+  /* Primer fotograma: el terminal no tiene nada que aprovechar */
+  if (screen->shown_color < 0)
+  {
+    screen_out_append(screen, CLEAR_SCREEN);
+    memset(screen->shown, '\0', (size_t)screen->rows * screen->columns);
+  }
+
+  for (r = 0; r < screen->rows; r++)
+  {
+    c = 0;
+    while (c < screen->columns)
+    {
+      i = r * screen->columns + c;
+      if (screen_cell_changed(screen, i, color) == FALSE)
+      {
+        c++;
+        continue;
+      }
+
+      /* Tramo de celdas cambiadas: se coloca el cursor una vez */
+      sprintf(escape, "\033[%d;%dH", r + 1, c + 1);
+      screen_out_append(screen, escape);
+      while (c < screen->columns)
+      {
+        i = r * screen->columns + c;
+
+        /* Un hueco corto sin cambios se reescribe; uno largo cierra el tramo */
+        if (screen_cell_changed(screen, i, color) == FALSE)
+        {
+          for (gap = 1; gap <= RUN_GAP && c + gap < screen->columns && screen_cell_changed(screen, i + gap, color) == FALSE; gap++)
+            ;
+          if (gap > RUN_GAP || c + gap >= screen->columns)
+          {
+            break;
+          }
+        }
+
+        next_style = (screen->data[i] == BG_CHAR) ? bg_style : FG_STYLE;
+        if (next_style != style)
+        {
+          screen_out_append(screen, next_style);
+          style = next_style;
+        }
+        screen->out[screen->out_len++] = screen->data[i];
+        c++;
+      }
+    }
+  }
+
+  /* Deja el cursor bajo el fotograma y borra el prompt anterior */
+  sprintf(escape, RESET_STYLE "\033[%d;1H\033[J", screen->rows + 1);
+  screen_out_append(screen, escape);
+  screen_out_flush(screen);
+
+  memcpy(screen->shown, screen->data, (size_t)screen->rows * screen->columns);
+  screen->shown_color = (int)color;
+}
+
+Area *screen_area_init(int x, int y, int width, int height)
+{
+  return screen_buffer_area_init(terminal, x, y, width, height);
+}
+
+void screen_area_destroy(Area *area)
+{
+  free(area);
+}
+
+void screen_area_clear(Area *area)
+{
+  int i;
+
+  if (!area)
+  {
+    return;
+  }
+
+  screen_area_reset_cursor(area);
+  for (i = 0; i < area->height; i++)
+  {
+    memset(screen_cell(area->screen, area->x, area->y + i), FG_CHAR, area->width);
+  }
+}
+
+void screen_area_reset_cursor(Area *area)
+{
+  if (area)
+  {
+    area->cursor = 0;
+  }
+}
+
+void screen_area_scroll_up(Area *area)
+{
+  int i;
+
+  for (i = 0; i < area->height - 1; i++)
+  {
+    memcpy(screen_cell(area->screen, area->x, area->y + i), screen_cell(area->screen, area->x, area->y + i + 1), area->width);
+  }
+  area->cursor = area->height - 1;
+}
+
+void screen_area_puts(Area *area, char *str)
+{
+  char *row = NULL;
+  BOOL pending = FALSE;
+  int len, i = 0, n;
+
+  if (!area || !str)
+  {
+    return;
+  }
+
+  /* Cada trozo de width caracteres ocupa una fila; una cadena vacia no avanza el cursor */
+  len = (int)strlen(str);
+  while (i < len)
+  {
+    if (area->cursor >= area->height)
+    {
+      screen_area_scroll_up(area);
+    }
+
+    row = screen_cell(area->screen, area->x, area->y + area->cursor);
+    memset(row, FG_CHAR, area->width);
+    for (n = 0; n < area->width && i < len; n++, i++)
+    {
+      /* Las vocales acentuadas y la enye ocupan dos bytes: se muestran como "??" */
+      if (pending == TRUE)
+      {
+        row[n] = '?';
+        pending = FALSE;
+      }
+      else if (str[i] == SPECIAL_LEAD && str[i + 1] != '\0' && strchr(SPECIAL_CHARS, str[i + 1]) != NULL)
+      {
+        row[n] = '?';
+        pending = TRUE;
+      }
+      else
+      {
+        row[n] = str[i];
+      }
+    }
+    area->cursor++;
+  }
+}
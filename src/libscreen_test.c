@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "libscreen.h"
+#include "libscreen_test.h"
+#include "test.h"
+#define MAX_TESTS 13
+int main(int argc, char** argv) {
+    int test = 0;
+    if (argc > 1) test = atoi(argv[1]);
+    if (test < 0 || test > MAX_TESTS) {
+        printf("Error: unknown test %d\t", test);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (test == 0 || test == 1) test1_screen_buffer_create();
+    if (test == 0 || test == 2) test2_screen_buffer_create();
+    if (test == 0 || test == 3) test1_screen_buffer_area_init();
+    if (test == 0 || test == 4) test2_screen_buffer_area_init();
+    if (test == 0 || test == 5) test1_screen_buffer_render();
+    if (test == 0 || test == 6) test2_screen_buffer_render();
+    if (test == 0 || test == 7) test3_screen_buffer_render();
+    if (test == 0 || test == 8) test1_screen_area_puts();
+    if (test == 0 || test == 9) test2_screen_area_puts();
+    if (test == 0 || test == 10) test3_screen_area_puts();
+    if (test == 0 || test == 11) test4_screen_area_puts();
+    if (test == 0 || test == 12) test5_screen_area_puts();
+    if (test == 0 || test == 13) test1_screen_area_clear();
+
+    PRINT_PASSED_PERCENTAGE;
+    return 0;
+}
+
+void test1_screen_buffer_create() {
+    ScreenBuffer *s = screen_buffer_create(3, 4);
+    PRINT_TEST_RESULT(s != NULL);
+    screen_buffer_destroy(s);
+}
+
+void test2_screen_buffer_create() {
+    PRINT_TEST_RESULT(screen_buffer_create(0, 4) == NULL);
+}
+
+void test1_screen_buffer_area_init() {
+    ScreenBuffer *s = screen_buffer_create(3, 4);
+    Area *a = screen_buffer_area_init(s, 1, 1, 2, 2);
+    PRINT_TEST_RESULT(a != NULL);
+    screen_area_destroy(a);
+    screen_buffer_destroy(s);
+}
+
+void test2_screen_buffer_area_init() {
+    ScreenBuffer *s = screen_buffer_create(3, 4);
+    PRINT_TEST_RESULT(screen_buffer_area_init(s, 3, 1, 2, 2) == NULL);
+    screen_buffer_destroy(s);
+}
+
+void test1_screen_buffer_render() {
+    ScreenBuffer *s = screen_buffer_create(2, 3);
+    char buf[16];
+    PRINT_TEST_RESULT(screen_buffer_render(s, buf, sizeof(buf)) == 8 && strcmp(buf, "~~~\n~~~\n") == 0);
+    screen_buffer_destroy(s);
+}
+
+void test2_screen_buffer_render() {
+    ScreenBuffer *s = screen_buffer_create(2, 3);
+    char buf[8];
+    /* Falta sitio para el '\0' */
+    PRINT_TEST_RESULT(screen_buffer_render(s, buf, sizeof(buf)) == -1);
+    screen_buffer_destroy(s);
+}
+
+void test3_screen_buffer_render() {
+    char buf[16];
+    PRINT_TEST_RESULT(screen_buffer_render(NULL, buf, sizeof(buf)) == -1);
+}
+
+void test1_screen_area_puts() {
+    ScreenBuffer *s = screen_buffer_create(3, 5);
+    Area *a = screen_buffer_area_init(s, 1, 1, 3, 1);
+    char buf[32];
+    screen_area_puts(a, "ab");
+    screen_buffer_render(s, buf, sizeof(buf));
+    PRINT_TEST_RESULT(strcmp(buf, "~~~~~\n~ab ~\n~~~~~\n") == 0);
+    screen_area_destroy(a);
+    screen_buffer_destroy(s);
+}
+
+void test2_screen_area_puts() {
+    ScreenBuffer *s = screen_buffer_create(2, 3);
+    Area *a = screen_buffer_area_init(s, 0, 0, 3, 2);
+    char buf[16];
+    /* Lo que no cabe en una fila pasa a la siguiente */
+    screen_area_puts(a, "abcde");
+    screen_buffer_render(s, buf, sizeof(buf));
+    PRINT_TEST_RESULT(strcmp(buf, "abc\nde \n") == 0);
+    screen_area_destroy(a);
+    screen_buffer_destroy(s);
+}
+
+void test3_screen_area_puts() {
+    ScreenBuffer *s = screen_buffer_create(2, 2);
+    Area *a = screen_buffer_area_init(s, 0, 0, 2, 2);
+    char buf[16];
+    /* Con el area llena las filas suben y la ultima se reescribe */
+    screen_area_puts(a, "a");
+    screen_area_puts(a, "b");
+    screen_area_puts(a, "c");
+    screen_buffer_render(s, buf, sizeof(buf));
+    PRINT_TEST_RESULT(strcmp(buf, "b \nc \n") == 0);
+    screen_area_destroy(a);
+    screen_buffer_destroy(s);
+}
+
+void test4_screen_area_puts() {
+    ScreenBuffer *s = screen_buffer_create(1, 4);
+    Area *a = screen_buffer_area_init(s, 0, 0, 4, 1);
+    char str[] = "a\303\261b", buf[8];
+    screen_area_puts(a, str);
+    screen_buffer_render(s, buf, sizeof(buf));
+    PRINT_TEST_RESULT(strcmp(buf, "a??b\n") == 0 && strcmp(str, "a\303\261b") == 0);
+    screen_area_destroy(a);
+    screen_buffer_destroy(s);
+}
+
+void test5_screen_area_puts() {
+    ScreenBuffer *s = screen_buffer_create(1, 4);
+    Area *a = screen_buffer_area_init(s, 0, 0, 4, 1);
+    char buf[8];
+    /* Solo los pares que empiezan por \303 se sustituyen: "\302\241" sale tal cual */
+    screen_area_puts(a, "\302\241\303\251");
+    screen_buffer_render(s, buf, sizeof(buf));
+    PRINT_TEST_RESULT(strcmp(buf, "\302\241??\n") == 0);
+    screen_area_destroy(a);
+    screen_buffer_destroy(s);
+}
+
+void test1_screen_area_clear() {
+    ScreenBuffer *s = screen_buffer_create(1, 3);
+    Area *a = screen_buffer_area_init(s, 0, 0, 3, 1);
+    char buf[8];
+    screen_area_puts(a, "abc");
+    screen_area_clear(a);
+    screen_area_puts(a, "d");
+    screen_buffer_render(s, buf, sizeof(buf));
+    PRINT_TEST_RESULT(strcmp(buf, "d  \n") == 0);
+    screen_area_destroy(a);
+    screen_buffer_destroy(s);
+}
@@ -13,19 +13,23 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define SINGLE_ELEM 1
-
 struct _Link
 {
     Id id;                /*!<  Identificador del enlace */
-    char nom[WORD_SIZE];  /*!< Nombre del enlace */
+    char *nom;            /*!< Nombre del enlace (reservado a su medida) */
     Id origin;            /*!< Id del espacio de origen */
     Id destination;       /*!< Id del espacio de destino */
     Directions direction; /*!< Dirección del enlace */
     BOOL open;            /*!< Indica si el enlace está abierto o cerrado */
+    Arena *arena;         /*!< Almacén del que sale la memoria (NULL si es del heap) */
 };
 
 Link *link_create(Id id)
+{
+    return link_create_in(NULL, id);
+}
+
+Link *link_create_in(Arena *arena, Id id)
 {
     Link *new_link = NULL;
 
@@ -35,7 +39,7 @@ Link *link_create(Id id)
         return NULL;
     }
 
-    new_link = (Link *)calloc(SINGLE_ELEM, sizeof(Link));
+    new_link = (Link *)arena_alloc(arena, sizeof(Link));
 
     /* Comprobación por si falla la reserva de memoria */
     if (new_link == NULL)
@@ -45,7 +49,8 @@ Link *link_create(Id id)
 
     /* Rellenamos los datos básicos con valores por defecto */
     new_link->id = id;
-    new_link->nom[0] = '\0';
+    new_link->arena = arena;
+    new_link->nom = NULL;
     new_link->origin = NO_ID;
     new_link->destination = NO_ID;
     new_link->direction = NO_DIRECTION;
@@ -63,20 +68,19 @@ Status link_destroy(Link *link)
     }
 
     /* Liberamos el enlace */
-    free(link);
+    arena_free(link->arena, link->nom);
+    arena_free(link->arena, link);
     return OK;
 }
 
 Status link_set_name(Link *link, char *name)
 {
-    /* Nos aseguramos de que ni el enlace ni el nombre sean NULL */
-    if (!link || !name)
+    /* Nos aseguramos de que el enlace no sea NULL y copiamos el nombre */
+    if (!link)
     {
         return ERROR;
     }
-    /* Copiamos el nombre */
-    strcpy(link->nom, name);
-    return OK;
+    return arena_set_string(link->arena, &link->nom, name);
 }
 
 Status link_set_origin(Link *link, Id origin)
@@ -133,6 +137,16 @@ Id link_get_id(Link *link)
     return link->id;
 }
 
+Arena *link_get_arena(Link *link)
+{
+    /* Comprueba si es NULL y devuelve su almacen */
+    if (!link)
+    {
+        return NULL;
+    }
+    return link->arena;
+}
+
 char *link_get_name(Link *link)
 {
     /* Comprueba si es NULL y devuelve el nombre */
@@ -140,7 +154,7 @@ char *link_get_name(Link *link)
     {
         return NULL;
     }
-    return link->nom;
+    return link->nom ? link->nom : "";
 }
 
 Id link_get_origin(Link *link)
@@ -203,7 +217,7 @@ Status link_print(Link *link)
     }
 
     /* Imprime toda la información almacenada en la estructura */
-    fprintf(stdout, "--> Link (Id: %ld; Name: %s)\n", link->id, link->nom);
+    fprintf(stdout, "--> Link (Id: %ld; Name: %s)\n", link->id, link_get_name(link));
     fprintf(stdout, "    | Origin: %ld\n", link->origin);
     fprintf(stdout, "    | Destination: %ld\n", link->destination);
     fprintf(stdout, "    | Direction (enum): %d\n", link->direction);
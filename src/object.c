@@ -11,8 +11,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#define SINGLE_ELEM 1
-#define FIRST_CHAR 0
 
 /**
  * @brief Object
@@ -21,15 +19,21 @@
 struct Object
 {
   Id id;                                     /*!< La ID del objeto */
-  char name[WORD_SIZE + SINGLE_ELEM];        /*!< Nombre del objeto */
-  char description[WORD_SIZE + SINGLE_ELEM]; /*!< Descripcion del objeto*/
+  char *name;                                /*!< Nombre del objeto (reservado a su medida) */
+  char *description;                         /*!< Descripcion del objeto (reservada a su medida) */
   int health;                                /*!<vida queaporta o quita*/
   BOOL movable;                              /*!<Si se puede mover o no*/
   Id dependency;                             /*!<Indica el id del que depende*/
   Id open;                                   /*!<Indica el id de lo que puede abrir*/
+  Arena *arena;                              /*!<Almacen del que sale la memoria (NULL si es del heap)*/
 };
 
 Object *object_create(Id id)
+{
+  return object_create_in(NULL, id);
+}
+
+Object *object_create_in(Arena *arena, Id id)
 {
   Object *newObject = NULL;
 
@@ -40,7 +44,7 @@ Object *object_create(Id id)
   }
 
   /* Reservamos memoria dinámica */
-  newObject = (Object *)calloc(SINGLE_ELEM, sizeof(Object));
+  newObject = (Object *)arena_alloc(arena, sizeof(Object));
 
   /* Control de error de memoria */
   if (newObject == NULL)
@@ -50,8 +54,9 @@ Object *object_create(Id id)
 
   /* Inicializamos los campos del objeto nuevo */
   newObject->id = id;
-  newObject->name[FIRST_CHAR] = '\0';
-  newObject->description[FIRST_CHAR] = '\0';
+  newObject->arena = arena;
+  newObject->name = NULL;
+  newObject->description = NULL;
   newObject->dependency = NO_ID;
   newObject->health = 0;
   newObject->open = NO_ID;
@@ -69,7 +74,9 @@ Status object_destroy(Object *object)
   }
 
   /* Liberamos la memoria */
-  free(object);
+  arena_free(object->arena, object->name);
+  arena_free(object->arena, object->description);
+  arena_free(object->arena, object);
   return OK;
 }
 
@@ -83,20 +90,24 @@ Id object_get_id(Object *object)
   return object->id;
 }
 
-Status object_set_name(Object *object, char *name)
+Arena *object_get_arena(Object *object)
 {
-  /* Comprobamos que los punteros sean válidos */
-  if (!object || !name)
+  /* Verificamos si hay objeto */
+  if (!object)
   {
-    return ERROR;
+    return NULL;
   }
+  return object->arena;
+}
 
-  /* Copiamos la cadena de texto */
-  if (!strcpy(object->name, name))
+Status object_set_name(Object *object, char *name)
+{
+  /* Comprobamos que los punteros sean válidos y copiamos la cadena */
+  if (!object)
   {
     return ERROR;
   }
-  return OK;
+  return arena_set_string(object->arena, &object->name, name);
 }
 
 const char *object_get_name(Object *object)
@@ -106,7 +117,7 @@ const char *object_get_name(Object *object)
   {
     return NULL;
   }
-  return object->name;
+  return object->name ? object->name : "";
 }
 
 Status object_print(Object *object)
@@ -118,21 +129,18 @@ Status object_print(Object *object)
   }
 
   /* Imprimimos datos por salida estándar */
-  fprintf(stdout, "--> Object (Id: %ld; Name: %s)\n", object->id, object->name);
+  fprintf(stdout, "--> Object (Id: %ld; Name: %s)\n", object->id, object_get_name(object));
 
   return OK;
 }
 
 Status object_set_desc(Object *object, char *desc)
 {
-  /*Compruebo que no sean NULL*/
-  if (!object || !desc)
-    return ERROR;
-  /*Copio las descripcion*/
-  if (!strcpy(object->description, desc))
+  /*Compruebo que no sea NULL*/
+  if (!object)
     return ERROR;
-
-  return OK;
+  /*Copio la descripcion*/
+  return arena_set_string(object->arena, &object->description, desc);
 }
 
 const char *object_get_desc(Object *object)
@@ -141,7 +149,7 @@ const char *object_get_desc(Object *object)
   {
     return NULL;
   } /*Devuelco la descripcion*/
-  return object->description;
+  return object->description ? object->description : "";
 }
 #include <stdio.h>
 #include <stdlib.h>
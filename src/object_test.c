@@ -13,7 +13,7 @@
 #include "object_test.h"
 #include "test.h"
 
-#define MAX_TESTS 16
+#define MAX_TESTS 18
 
 /**
  * @brief Función principal de pruebas para el módulo Space.
@@ -56,6 +56,8 @@ int main(int argc, char** argv) {
     if (all || test == 14) test2_object_set_desc();
     if (all || test == 15) test1_object_get_desc();
     if (all || test == 16) test2_object_get_desc();
+    if (all || test == 17) test3_object_set_name();
+    if (all || test == 18) test3_object_get_desc();
 
 
     PRINT_PASSED_PERCENTAGE;
@@ -153,3 +155,19 @@ void test1_object_get_desc() {
 void test2_object_get_desc() {
     PRINT_TEST_RESULT(object_get_desc(NULL) == NULL);
 }
+
+void test3_object_set_name() {
+    Object *o;
+    o = object_create(1);
+    object_set_name(o, "a");
+    object_set_name(o, "a much longer object name");
+    PRINT_TEST_RESULT(strcmp(object_get_name(o), "a much longer object name") == 0);
+    object_destroy(o);
+}
+
+void test3_object_get_desc() {
+    Object *o;
+    o = object_create(1);
+    PRINT_TEST_RESULT(strcmp(object_get_desc(o), "") == 0);
+    object_destroy(o);
+}
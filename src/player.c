@@ -12,11 +12,8 @@
 #include <string.h>
 
 /* Definiciones para evitar números mágicos */
-#define SINGLE_ELEM 1
-#define FIRST_CHAR 0
 #define START_HEALTH 3
 
-
 /**
  * @brief Player
  * Estructura de Jugador que contiene el ID, nombre, ubicación actual e ID del objeto que transporta.
@@ -24,15 +21,21 @@
 struct Player
 {
   Id id;                              /*!< Id del jugador*/
-  char name[WORD_SIZE + SINGLE_ELEM]; /*!< Nombre del jugador*/
+  char *name;                         /*!< Nombre del jugador (reservado a su medida)*/
   Id location;                        /*!< Ubicación actual del jugador*/
   Inventory *backpack;                /*!< Inventario del jugador*/
   int nobj;                           /*!< Número de objetos en el inventario*/
   int health;                         /*!< Puntos de salud del jugador*/
   char *gdesc;                        /*!< Descripción gráfica del jugador*/
+  Arena *arena;                       /*!< Almacén del que sale la memoria (NULL si es del heap)*/
 };
 
 Player *player_create(Id id)
+{
+  return player_create_in(NULL, id);
+}
+
+Player *player_create_in(Arena *arena, Id id)
 {
   Player *newPlayer = NULL;
 
@@ -43,7 +46,7 @@ Player *player_create(Id id)
   }
 
   /* Reserva memoria para un único elemento Player */
-  newPlayer = (Player *)calloc(SINGLE_ELEM, sizeof(Player));
+  newPlayer = (Player *)arena_alloc(arena, sizeof(Player));
 
   /* Comprueba si hubo un error al reservar memoria */
   if (newPlayer == NULL)
@@ -53,9 +56,10 @@ Player *player_create(Id id)
 
   /* Inicializa los valores por defecto del jugador */
   newPlayer->id = id;
-  newPlayer->name[FIRST_CHAR] = '\0';
+  newPlayer->arena = arena;
+  newPlayer->name = NULL;
   newPlayer->location = NO_ID;
-  newPlayer->backpack = inventory_create(INVENTORY_SIZE);
+  newPlayer->backpack = inventory_create_in(arena, INVENTORY_SIZE);
   newPlayer->health = START_HEALTH;
   newPlayer->gdesc = NULL;
 
@@ -71,15 +75,13 @@ Status player_destroy(Player *player)
   }
 
   /* Libera la memoria */
-  if (player->gdesc)
-  {
-    free(player->gdesc);
-  }
+  arena_free(player->arena, player->name);
+  arena_free(player->arena, player->gdesc);
   if (player->backpack)
   {
     inventory_destroy(player->backpack);
   }
-  free(player);
+  arena_free(player->arena, player);
   return OK;
 }
 
@@ -93,20 +95,24 @@ Id player_get_id(Player *player)
   return player->id;
 }
 
-Status player_set_name(Player *player, char *name)
+Arena *player_get_arena(Player *player)
 {
-  /* Verifica que el jugador y el nombre existan */
-  if (!player || !name)
+  /* Comprueba que el puntero no sea NULL */
+  if (!player)
   {
-    return ERROR;
+    return NULL;
   }
+  return player->arena;
+}
 
-  /* Copia el nombre y comprueba si falla */
-  if (!strcpy(player->name, name))
+Status player_set_name(Player *player, char *name)
+{
+  /* Verifica que el jugador exista y copia el nombre */
+  if (!player)
   {
     return ERROR;
   }
-  return OK;
+  return arena_set_string(player->arena, &player->name, name);
 }
 
 const char *player_get_name(Player *player)
@@ -116,7 +122,7 @@ const char *player_get_name(Player *player)
   {
     return NULL;
   }
-  return player->name;
+  return player->name ? player->name : "";
 }
 
 Status player_set_location(Player *player, Id location)
@@ -206,7 +212,7 @@ Status player_print(Player *player)
   }
 
   /* Imprime la información*/
-  fprintf(stdout, "--> Jugador (Id: %ld; Nombre: %s; Descripción: %s)\n", player->id, player->name, player->gdesc ? player->gdesc : "None");
+  fprintf(stdout, "--> Jugador (Id: %ld; Nombre: %s; Descripción: %s)\n", player->id, player_get_name(player), player->gdesc ? player->gdesc : "None");
   fprintf(stdout, "--> Salud: %d\n", player->health);
   fprintf(stdout, "--> Localización: %ld\n", player->location);
   inventory_print(player->backpack);
@@ -232,21 +238,11 @@ int player_get_health(Player *player)
 }
 Status player_set_gdesc(Player *player, char *des)
 { /*Cambia descripcion del jugador,si la descripcion es NULL devielve error*/
-  if (!player || !des)
-  {
-    return ERROR;
-  }
-  if (player->gdesc)
-  {
-    free(player->gdesc);
-  }
-  player->gdesc = (char *)malloc((strlen(des) + 1) * sizeof(char));
-  if (!player->gdesc)
+  if (!player)
   {
     return ERROR;
   }
-  strcpy(player->gdesc, des);
-  return OK;
+  return arena_set_string(player->arena, &player->gdesc, des);
 }
 char *player_get_gdesc(Player *player)
 { /*Devuelve la descripcion, comprueba puntero */
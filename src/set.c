@@ -13,23 +13,162 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_IDS 100
+#define INIT_IDS 4      /* Ids que caben en la propia estructura */
+#define HASH_MIN_IDS 8  /* A partir de este tamaño las búsquedas usan la tabla hash */
+
 /**
  * @brief Set
  * Estructura de datos que representa un conjunto de identificadores.
+ * Los Ids se guardan en orden de inserción; los conjuntos grandes tienen además
+ * una tabla hash de direccionamiento abierto para comprobar la pertenencia.
  */
 struct Set
 {
-    Id ids[MAX_IDS]; /*!<  Array interno de identificadores */
-    int n_ids;       /*!< Número actual de identificadores almacenados */
+    Id *ids;                  /*!< Array de identificadores (crece por duplicación) */
+    int n_ids;                /*!< Número actual de identificadores almacenados */
+    int capacity;             /*!< Número de huecos reservados en ids */
+    Id inline_ids[INIT_IDS];  /*!< Huecos iniciales, sin reserva aparte */
+    Id *buckets;              /*!< Tabla hash de Ids, NO_ID si la cubeta está libre (NULL si no hay) */
+    int n_buckets;            /*!< Número de cubetas (potencia de dos) */
+    Arena *arena;             /*!< Almacén del que sale la memoria (NULL si es del heap) */
 };
 
+int set_hash(Id id, int n_buckets);
+int set_bucket_find(Set *s, Id id);
+void set_bucket_insert(Set *s, Id id);
+void set_bucket_del(Set *s, Id id);
+Status set_rehash(Set *s);
+Status set_grow(Set *s);
+
+int set_hash(Id id, int n_buckets)
+{
+    unsigned long h = (unsigned long)id;
+
+    /* Mezcla de bits para repartir Ids consecutivos o con saltos regulares */
+    h ^= h >> 16;
+    h *= 0x45d9f3bUL;
+    h ^= h >> 16;
+
+    return (int)(h & (unsigned long)(n_buckets - 1));
+}
+
+int set_bucket_find(Set *s, Id id)
+{
+    int i;
+
+    for (i = set_hash(id, s->n_buckets); s->buckets[i] != NO_ID; i = (i + 1) & (s->n_buckets - 1))
+    {
+        if (s->buckets[i] == id)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void set_bucket_insert(Set *s, Id id)
+{
+    int i;
+
+    for (i = set_hash(id, s->n_buckets); s->buckets[i] != NO_ID; i = (i + 1) & (s->n_buckets - 1))
+        ;
+    s->buckets[i] = id;
+}
+
+void set_bucket_del(Set *s, Id id)
+{
+    int hole, i, home;
+
+    hole = set_bucket_find(s, id);
+    if (hole < 0)
+    {
+        return;
+    }
+
+    /* Borrado por desplazamiento: las claves que saltaron el hueco retroceden */
+    s->buckets[hole] = NO_ID;
+    for (i = (hole + 1) & (s->n_buckets - 1); s->buckets[i] != NO_ID; i = (i + 1) & (s->n_buckets - 1))
+    {
+        home = set_hash(s->buckets[i], s->n_buckets);
+        if (((i - home) & (s->n_buckets - 1)) >= ((i - hole) & (s->n_buckets - 1)))
+        {
+            s->buckets[hole] = s->buckets[i];
+            s->buckets[i] = NO_ID;
+            hole = i;
+        }
+    }
+}
+
+Status set_rehash(Set *s)
+{
+    Id *buckets = NULL;
+    int n_buckets = 4 * HASH_MIN_IDS, i;
+
+    while (n_buckets < 2 * s->n_ids)
+    {
+        n_buckets *= 2;
+    }
+
+    buckets = (Id *)arena_alloc(s->arena, n_buckets * sizeof(Id));
+    if (buckets == NULL)
+    {
+        return ERROR;
+    }
+    for (i = 0; i < n_buckets; i++)
+    {
+        buckets[i] = NO_ID;
+    }
+
+    arena_free(s->arena, s->buckets);
+    s->buckets = buckets;
+    s->n_buckets = n_buckets;
+    for (i = 0; i < s->n_ids; i++)
+    {
+        set_bucket_insert(s, s->ids[i]);
+    }
+
+    return OK;
+}
+
+Status set_grow(Set *s)
+{
+    Id *ids = NULL;
+
+    /* Los huecos iniciales no se pueden realojar: se copian a memoria propia */
+    if (s->ids == s->inline_ids)
+    {
+        ids = (Id *)arena_alloc(s->arena, 2 * s->capacity * sizeof(Id));
+        if (ids != NULL)
+        {
+            memcpy(ids, s->inline_ids, s->n_ids * sizeof(Id));
+        }
+    }
+    else
+    {
+        ids = (Id *)arena_realloc(s->arena, s->ids, s->capacity * sizeof(Id), 2 * s->capacity * sizeof(Id));
+    }
+    if (ids == NULL)
+    {
+        return ERROR;
+    }
+
+    s->ids = ids;
+    s->capacity *= 2;
+    return OK;
+}
+
 Set *set_create()
+{
+    return set_create_in(NULL);
+}
+
+Set *set_create_in(Arena *arena)
 {
     Set *s = NULL;
     int i;
 
-    s = (Set *)malloc(sizeof(Set));
+    s = (Set *)arena_alloc(arena, sizeof(Set));
 
     /* Comprueba si falla la reserva de memoria */
     if (s == NULL)
@@ -37,11 +176,16 @@ Set *set_create()
         return NULL;
     }
 
-    /* Inicializamos el número de elementos a 0 */
+    /* Los primeros Ids se guardan dentro de la propia estructura */
+    s->arena = arena;
+    s->ids = s->inline_ids;
     s->n_ids = 0;
+    s->capacity = INIT_IDS;
+    s->buckets = NULL;
+    s->n_buckets = 0;
 
     /* Rellenamos el array de IDs con NO_ID */
-    for (i = 0; i < MAX_IDS; i++)
+    for (i = 0; i < INIT_IDS; i++)
     {
         s->ids[i] = NO_ID;
     }
@@ -57,15 +201,20 @@ Status set_destroy(Set *s)
         return ERROR;
     }
 
-    /* Libera la memoria del conjunto */
-    free(s);
+    /* Libera la memoria del conjunto (nada si sale de un almacén) */
+    if (s->ids != s->inline_ids)
+    {
+        arena_free(s->arena, s->ids);
+    }
+    arena_free(s->arena, s->buckets);
+    arena_free(s->arena, s);
     return OK;
 }
 
 Status set_add(Set *s, Id id)
 {
-    /* Comprueba que el conjunto, el ID y la capacidad sean válidos */
-    if (s == NULL || id == NO_ID || s->n_ids >= MAX_IDS)
+    /* Comprueba que el conjunto y el ID sean válidos */
+    if (s == NULL || id == NO_ID)
     {
         return ERROR;
     }
@@ -76,16 +225,35 @@ Status set_add(Set *s, Id id)
         return ERROR;
     }
 
+    /* Si el array esta lleno se duplica su capacidad */
+    if (s->n_ids >= s->capacity && set_grow(s) == ERROR)
+    {
+        return ERROR;
+    }
+
     /* Añade el ID en la primera posición libre y aumenta el contador */
     s->ids[s->n_ids] = id;
     s->n_ids++;
 
+    /* La tabla hash se crea al llegar a HASH_MIN_IDS y se mantiene como mucho medio llena */
+    if (s->buckets != NULL && 2 * s->n_ids <= s->n_buckets)
+    {
+        set_bucket_insert(s, id);
+    }
+    else if (s->n_ids >= HASH_MIN_IDS && set_rehash(s) == ERROR)
+    {
+        /* Sin memoria para la tabla las búsquedas vuelven a recorrer el array */
+        arena_free(s->arena, s->buckets);
+        s->buckets = NULL;
+        s->n_buckets = 0;
+    }
+
     return OK;
 }
 
 Status set_del(Set *s, Id id)
 {
-    int i, j;
+    int i;
 
     /* Comprueba que el conjunto y el ID sean válidos */
     if (s == NULL || id == NO_ID)
@@ -93,26 +261,32 @@ Status set_del(Set *s, Id id)
         return ERROR;
     }
 
-    for (i = 0; i < s->n_ids; i++)
+    /* Busca el ID a eliminar: hace falta su posición aunque haya tabla hash */
+    for (i = 0; i < s->n_ids && s->ids[i] != id; i++)
+        ;
+    if (i == s->n_ids)
     {
-        /* Busca el ID a eliminar */
-        if (s->ids[i] == id)
-        {
-            /* Desplaza los elementos hacia la izquierda para rellenar el hueco */
-            for (j = i; j < s->n_ids - 1; j++)
-            {
-                s->ids[j] = s->ids[j + 1];
-            }
-
-            /* Elimina el último elemento duplicado y reduce el contador */
-            s->ids[s->n_ids - 1] = NO_ID;
-            s->n_ids--;
+        return ERROR;
+    }
 
-            return OK;
-        }
+    if (s->buckets != NULL)
+    {
+        set_bucket_del(s, id);
     }
 
-    return ERROR;
+    /*
+     * Desplaza los elementos hacia la izquierda para mantener el orden de
+     * inserción, que es el orden en que se muestran. Intercambiar con el
+     * último sería O(1) pero cambiaría lo que ve el jugador; los conjuntos
+     * del juego son pequeños y el coste O(n) es deliberado.
+     */
+    memmove(s->ids + i, s->ids + i + 1, (s->n_ids - i - 1) * sizeof(Id));
+
+    /* Elimina el último elemento duplicado y reduce el contador */
+    s->ids[s->n_ids - 1] = NO_ID;
+    s->n_ids--;
+
+    return OK;
 }
 
 Status set_find(Set *s, Id id)
@@ -125,6 +299,12 @@ Status set_find(Set *s, Id id)
         return ERROR;
     }
 
+    /* Los conjuntos grandes se consultan en la tabla hash */
+    if (s->buckets != NULL)
+    {
+        return set_bucket_find(s, id) >= 0 ? OK : ERROR;
+    }
+
     /* Busca el ID en el array */
     for (i = 0; i < s->n_ids; i++)
     {
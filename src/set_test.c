@@ -15,7 +15,7 @@
 #include "set_test.h"
 #include "test.h"
 
-#define MAX_TESTS 16
+#define MAX_TESTS 20
 
 /**
  * @brief Main function for SET unit tests.
@@ -60,6 +60,10 @@ int main(int argc, char** argv) {
   if (all || test == 14) test2_set_get_ids();
   if (all || test == 15) test1_set_destroy();
   if (all || test == 16) test2_set_destroy();
+  if (all || test == 17) test3_set_add();
+  if (all || test == 18) test4_set_add();
+  if (all || test == 19) test3_set_del();
+  if (all || test == 20) test3_set_find();
 
   PRINT_PASSED_PERCENTAGE;
 
@@ -92,6 +96,18 @@ void test2_set_add() {
   PRINT_TEST_RESULT(set_add(s, 10) == ERROR);
 }
 
+void test3_set_add() {
+  Set *s;
+  int i, ok = 1;
+  s = set_create();
+  /* Supera la capacidad inicial varias veces */
+  for (i = 1; i <= 1000; i++) {
+    if (set_add(s, i) != OK) ok = 0;
+  }
+  PRINT_TEST_RESULT(ok && set_get_numberid(s) == 1000 && set_find(s, 1000) == OK);
+  set_destroy(s);
+}
+
 void test1_set_del() {
   Set *s;
   s = set_create(1);
@@ -177,3 +193,40 @@ void test2_set_destroy() {
   Set *s = NULL;
   PRINT_TEST_RESULT(set_destroy(s) == ERROR);
 }
+
+void test4_set_add() {
+  Set *s;
+  int i, ok = 1;
+  s = set_create();
+  for (i = 1; i <= 5000; i++) {
+    if (set_add(s, (Id)i * 37) != OK) ok = 0;
+  }
+  PRINT_TEST_RESULT(ok && set_get_numberid(s) == 5000 && set_add(s, 37 * 2500) == ERROR);
+  set_destroy(s);
+}
+
+void test3_set_del() {
+  Set *s;
+  int i, ok = 1;
+  s = set_create();
+  for (i = 1; i <= 100; i++) set_add(s, i);
+  for (i = 2; i <= 100; i += 2) set_del(s, i);
+  for (i = 0; i < 50; i++) {
+    if (set_get_id(s, i) != 2 * i + 1) ok = 0;
+  }
+  PRINT_TEST_RESULT(ok && set_get_numberid(s) == 50);
+  set_destroy(s);
+}
+
+void test3_set_find() {
+  Set *s;
+  int i, ok = 1;
+  s = set_create();
+  for (i = 1; i <= 1000; i++) set_add(s, i);
+  for (i = 1; i <= 1000; i += 3) set_del(s, i);
+  for (i = 1; i <= 1000; i++) {
+    if (set_find(s, i) != ((i - 1) % 3 == 0 ? ERROR : OK)) ok = 0;
+  }
+  PRINT_TEST_RESULT(ok && set_find(s, 1001) == ERROR);
+  set_destroy(s);
+}
@@ -14,11 +14,6 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define SINGLE_ELEM 1
-#define FIRST_CHAR 0
-#define MAX_SPACES 100
-#define MAX_LINKS 4
-
 /**
  * @brief Space
  * Estructura de datos que representa un espacio en el juego.
@@ -26,14 +21,22 @@
 struct Space
 {
   Id id;                              /*!< identificador de espacio*/
-  char name[WORD_SIZE + SINGLE_ELEM]; /*!< nombre del espacio*/
+  char *name;                         /*!< nombre del espacio (reservado a su medida)*/
   Set *objects;                       /*!< conjunto de los id de los objetos que contiene*/
   Set *characters;                   /*!< conjunto de los id de los caracteres*/
   char gdesc[GDESC_ROWS][GDESC_COLS]; /*!< Lo que hay que pintar el espacio*/
   BOOL discovered;                    /*!< Si esta descubierto o no*/
+  Link *links[N_DIRECTIONS];          /*!< enlaces salientes indexados por direccion*/
+  Arena *arena;                       /*!< almacen del que sale la memoria (NULL si es del heap)*/
+  long revision;                      /*!< Se incrementa con cada cambio del espacio*/
 };
 
 Space *space_create(Id id)
+{
+  return space_create_in(NULL, id);
+}
+
+Space *space_create_in(Arena *arena, Id id)
 {
   Space *newSpace = NULL;
   int i, j;
@@ -44,7 +47,7 @@ Space *space_create(Id id)
     return NULL;
   }
 
-  newSpace = (Space *)calloc(SINGLE_ELEM, sizeof(Space));
+  newSpace = (Space *)arena_alloc(arena, sizeof(Space));
 
   /* ccomprobacion por si es null  */
   if (newSpace == NULL)
@@ -54,10 +57,16 @@ Space *space_create(Id id)
 
   /* Rellenamos los datos básicos */
   newSpace->id = id;
-  newSpace->name[FIRST_CHAR] = '\0';
-  newSpace->objects = set_create();
-  newSpace->characters = set_create();
+  newSpace->arena = arena;
+  newSpace->name = NULL;
+  newSpace->objects = set_create_in(arena);
+  newSpace->characters = set_create_in(arena);
   newSpace->discovered = FALSE;
+  newSpace->revision = 0;
+  for (i = 0; i < N_DIRECTIONS; i++)
+  {
+    newSpace->links[i] = NULL;
+  }
 
   /* Limpiamos el dibujo del espacio dejándolo en blanco para empezar de cero */
   for (i = 0; i < GDESC_ROWS; i++)
@@ -91,7 +100,8 @@ Status space_destroy(Space *space)
   }
 
   /*Liberamos el espacio*/
-  free(space);
+  arena_free(space->arena, space->name);
+  arena_free(space->arena, space);
   return OK;
 }
 
@@ -105,17 +115,24 @@ Id space_get_id(Space *space)
   return space->id;
 }
 
-Status space_set_name(Space *space, char *name)
+Arena *space_get_arena(Space *space)
 {
-  /* Nos aseguramos de que ni la sala ni el nombre que le queremos poner NULL */
-  if (!space || !name)
+  /* Comprueba si la sala existe y te devuelve su almacen */
+  if (!space)
   {
-    return ERROR;
+    return NULL;
   }
-  if (!strcpy(space->name, name))
+  return space->arena;
+}
+
+Status space_set_name(Space *space, char *name)
+{
+  /* Nos aseguramos de que ni la sala ni el nombre que le queremos poner NULL */
+  if (!space || arena_set_string(space->arena, &space->name, name) == ERROR)
   {
     return ERROR;
   }
+  space->revision++;
   return OK;
 }
 
@@ -126,27 +143,104 @@ const char *space_get_name(Space *space)
   {
     return NULL;
   }
-  return space->name;
+  return space->name ? space->name : "";
+}
+
+Status space_add_link(Space *space, Link *link)
+{
+  Directions dir;
+
+  /* Comprueba el espacio, el enlace y su direccion */
+  if (!space || !link)
+  {
+    return ERROR;
+  }
+  dir = link_get_direction(link);
+  if (dir < 0 || dir >= N_DIRECTIONS)
+  {
+    return ERROR;
+  }
+
+  /* Si ya hay un enlace en esa direccion se conserva el primero */
+  if (space->links[dir] != NULL)
+  {
+    return ERROR;
+  }
+
+  space->links[dir] = link;
+  space->revision++;
+  return OK;
+}
+
+Link *space_get_link(Space *space, Id link_id)
+{
+  int i;
+
+  if (!space || link_id == NO_ID)
+  {
+    return NULL;
+  }
+
+  /* Busca el enlace entre los huecos de direccion */
+  for (i = 0; i < N_DIRECTIONS; i++)
+  {
+    if (space->links[i] && link_get_id(space->links[i]) == link_id)
+    {
+      return space->links[i];
+    }
+  }
+  return NULL;
+}
+
+Link *space_get_link_at(Space *space, Directions dir)
+{
+  /* Lectura directa del hueco de la direccion */
+  if (!space || dir < 0 || dir >= N_DIRECTIONS)
+  {
+    return NULL;
+  }
+  return space->links[dir];
+}
+
+int space_get_number_of_links(Space *space)
+{
+  int i, n = 0;
+
+  if (!space)
+  {
+    return -1;
+  }
+
+  for (i = 0; i < N_DIRECTIONS; i++)
+  {
+    if (space->links[i])
+    {
+      n++;
+    }
+  }
+  return n;
 }
 
 Status space_add_object(Space *space, Id object_id)
 {
   /* Revisa que haya sala y mete el objeto  */
-  if (!space)
+  if (!space || set_add(space->objects, object_id) == ERROR)
   {
     return ERROR;
   }
-  return set_add(space->objects, object_id);
+  space->revision++;
+  return OK;
 }
 
 Status space_remove_object(Space *space, Id object_id)
 {
   /* Si la sala existe, busca el objeto y lo borra de ahí */
-  if (!space)
+  if (!space || set_del(space->objects, object_id) == ERROR)
   {
     return ERROR;
   }
-  return set_del(space->objects, object_id);
+  space->revision++;
+  return OK;
 }
 
 Id *space_get_objects(Space *space)
@@ -194,18 +288,19 @@ Status space_set_character(Space *space, Id id)
   {
     return ERROR;
   }
+  space->revision++;
   return OK;
 }
 
 Status space_remove_character(Space *space, Id id)
 {
   /* Elimina a un personaje del espacio */
-  if (!space)
+  if (!space || set_del(space->characters, id) == ERROR)
   {
     return ERROR;
   }
-
-  return set_del(space->characters, id);
+  space->revision++;
+  return OK;
 }
 
 Id space_get_character(Space *space, int index)
@@ -235,6 +330,7 @@ Status space_set_gdesc(Space *space, char gdesc[GDESC_ROWS][GDESC_COLS])
     space->gdesc[i][GDESC_COLS - 1] = '\0'; /* Aseguramos que la línea termine bien */
   }
 
+  space->revision++;
   return OK;
 }
 
@@ -256,7 +352,11 @@ Status space_set_discovered(Space *space, BOOL discovered)
   {
     return ERROR;
   }
-  space->discovered = discovered;
+  if (space->discovered != discovered)
+  {
+    space->discovered = discovered;
+    space->revision++;
+  }
   return OK;
 }
 
@@ -280,7 +380,7 @@ Status space_print(Space *space)
     return ERROR;
   }
 
-  fprintf(stdout, "--> Space (Id: %ld; Name: %s)\n", space->id, space->name);
+  fprintf(stdout, "--> Space (Id: %ld; Name: %s)\n", space->id, space_get_name(space));
 
   /* Solo imprimimos los detalles internos si la sala ya fue descubierta */
   if (space->discovered == TRUE)
@@ -309,11 +409,6 @@ Status space_print(Space *space)
         fprintf(stdout, "%d ", (int)objs[i]);
       }
       fprintf(stdout, ")\n");
-
-      if (objs)
-      {
-        free(objs);
-      }
     }
     else
     {
@@ -332,8 +427,17 @@ int space_get_n_characters(Space *space)
   }
   return set_get_numberid(space->characters);
 }
+
+long space_get_revision(Space *space)
+{
+  if (!space)
+  {
+    return -1;
+  }
+  return space->revision;
+}
 char *space_get_gdes_from_index(Space*s, int n){
-if(!s||n>=5||n<0){
+if(!s||n>=GDESC_ROWS||n<0){
   return NULL;
 }
 return s->gdesc[n];
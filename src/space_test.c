@@ -16,7 +16,7 @@
 #include "test.h"
 #include "link.h"
 
-#define MAX_TESTS 33
+#define MAX_TESTS 40
 
 /** 
  * @brief Main function for SPACE unit tests. 
@@ -78,6 +78,13 @@ int main(int argc, char** argv) {
   if (all || test == 31) test2_space_set_gdesc();
   if (all || test == 32) test1_space_get_gdesc();
   if (all || test == 33) test2_space_get_gdesc();
+  if (all || test == 34) test1_space_add_link();
+  if (all || test == 35) test2_space_add_link();
+  if (all || test == 36) test1_space_get_link_at();
+  if (all || test == 37) test2_space_get_link_at();
+  if (all || test == 38) test1_space_get_revision();
+  if (all || test == 39) test2_space_get_revision();
+  if (all || test == 40) test3_space_get_revision();
 
   PRINT_PASSED_PERCENTAGE;
 
@@ -232,14 +239,14 @@ void test1_space_get_character() {
     Space *s;
     s = space_create(1);
     space_set_character(s, 20);
-    PRINT_TEST_RESULT(space_get_character(s) == 20);
+    PRINT_TEST_RESULT(space_get_character(s, 0) == 20);
     space_destroy(s);
 }
 
 void test2_space_get_character() {
     Space *s;
     s = space_create(1);
-    PRINT_TEST_RESULT(space_get_character(s) == NO_ID);
+    PRINT_TEST_RESULT(space_get_character(s, 0) == NO_ID);
     space_destroy(s);
 }
 
@@ -322,7 +329,69 @@ void test2_space_get_gdesc() {
     PRINT_TEST_RESULT(space_get_gdesc(s) == NULL);
 }
 
+void test1_space_add_link() {
+  Space *s;
+  Link *l;
+  s = space_create(1);
+  l = link_create(10);
+  link_set_direction(l, N);
+  PRINT_TEST_RESULT(space_add_link(s, l) == OK);
+  link_destroy(l);
+  space_destroy(s);
+}
+
+void test2_space_add_link() {
+  Space *s = NULL;
+  Link *l;
+  l = link_create(10);
+  link_set_direction(l, N);
+  PRINT_TEST_RESULT(space_add_link(s, l) == ERROR);
+  link_destroy(l);
+}
 
+void test1_space_get_link_at() {
+  Space *s;
+  Link *l;
+  s = space_create(1);
+  l = link_create(10);
+  link_set_direction(l, E);
+  space_add_link(s, l);
+  PRINT_TEST_RESULT(space_get_link_at(s, E) == l);
+  link_destroy(l);
+  space_destroy(s);
+}
+
+void test2_space_get_link_at() {
+  Space *s;
+  s = space_create(1);
+  PRINT_TEST_RESULT(space_get_link_at(s, W) == NULL);
+  space_destroy(s);
+}
 
+void test1_space_get_revision() {
+  Space *s;
+  long r;
+  s = space_create(1);
+  r = space_get_revision(s);
+  space_add_object(s, 5);
+  PRINT_TEST_RESULT(space_get_revision(s) != r);
+  space_destroy(s);
+}
 
+void test2_space_get_revision() {
+  Space *s;
+  long r;
+  s = space_create(1);
+  space_set_discovered(s, TRUE);
+  r = space_get_revision(s);
+  /* Ni repetir un valor ni fallar al borrar cambian el espacio */
+  space_set_discovered(s, TRUE);
+  space_remove_object(s, 5);
+  PRINT_TEST_RESULT(space_get_revision(s) == r);
+  space_destroy(s);
+}
 
+void test3_space_get_revision() {
+  Space *s = NULL;
+  PRINT_TEST_RESULT(space_get_revision(s) == -1);
+}
@@ -1,4 +1,3 @@
-#include "test.h"
 #include <stdio.h>
 
 static int total_tests = 0;
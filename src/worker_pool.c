@@ -0,0 +1,519 @@
+/**
+ * @brief Implementa el conjunto de hilos con robo de trabajo
+ *
+ * Cada hilo tiene una cola doble de sesiones listas. Saca trabajo de su
+ * propio extremo inferior y, si no le queda, roba del extremo superior de
+ * las colas de los demás. Una sesión está como mucho en una cola a la vez,
+ * así que sus tareas nunca se solapan y se ejecutan en orden de envío.
+ *
+ * @file worker_pool.c
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "worker_pool.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INIT_DEQUE 16
+#define STRAND_BATCH 16
+
+/**
+ * @brief WorkerTask
+ * Tarea pendiente de una sesión (lista enlazada en orden de envío).
+ */
+typedef struct _WorkerTask
+{
+  WorkerTaskFn run;          /*!< Funcion que ejecuta la tarea */
+  void *arg;                 /*!< Argumento de run */
+  struct _WorkerTask *next;  /*!< Siguiente tarea de la sesion */
+} WorkerTask;
+
+/**
+ * @brief WorkerDeque
+ * Cola doble circular de sesiones listas de un hilo.
+ */
+typedef struct _WorkerDeque
+{
+  WorkerStrand **items;      /*!< Huecos de la cola circular */
+  int capacity;              /*!< Numero de huecos reservados */
+  int top;                   /*!< Posicion del extremo superior (el que se roba) */
+  int n_items;               /*!< Numero de sesiones en la cola */
+  pthread_mutex_t lock;      /*!< Protege la cola */
+} WorkerDeque;
+
+/**
+ * @brief Worker
+ * Hilo del conjunto con su cola.
+ */
+typedef struct _Worker
+{
+  WorkerPool *pool;          /*!< Conjunto al que pertenece */
+  pthread_t thread;          /*!< Hilo del sistema */
+  WorkerDeque deque;         /*!< Sesiones listas de este hilo */
+} Worker;
+
+/**
+ * @brief WorkerStrand
+ * Sesión: cola de tareas que se ejecutan de una en una.
+ */
+struct _WorkerStrand
+{
+  WorkerPool *pool;          /*!< Conjunto al que pertenece */
+  WorkerTask *head;          /*!< Primera tarea pendiente */
+  WorkerTask *tail;          /*!< Ultima tarea pendiente */
+  BOOL scheduled;            /*!< Esta en una cola o ejecutandose */
+  pthread_mutex_t lock;      /*!< Protege las tareas y scheduled */
+  pthread_cond_t idle;       /*!< Se avisa cuando scheduled pasa a FALSE */
+};
+
+/**
+ * @brief WorkerPool
+ * Hilos, colas y contador global de sesiones listas para dormir y despertar.
+ */
+struct _WorkerPool
+{
+  Worker *workers;           /*!< Hilos del conjunto */
+  int n_workers;             /*!< Numero de hilos */
+  int n_strands;             /*!< Sesiones vivas (cota de cada cola) */
+  int n_ready;               /*!< Sesiones esperando en alguna cola */
+  int next_worker;           /*!< Reparto circular de envios externos */
+  BOOL shutdown;             /*!< Los hilos terminan al vaciarse las colas */
+  pthread_mutex_t lock;      /*!< Protege los contadores y shutdown */
+  pthread_cond_t ready;      /*!< Se avisa cuando hay una sesion lista */
+  pthread_key_t current;     /*!< Worker del hilo actual, NULL fuera del conjunto */
+};
+
+Status worker_pool_deque_reserve(WorkerDeque *deque, int capacity);
+void worker_pool_deque_push(WorkerDeque *deque, WorkerStrand *strand, BOOL at_top);
+WorkerStrand *worker_pool_deque_pop(WorkerDeque *deque, BOOL from_top);
+void worker_pool_schedule(WorkerPool *pool, Worker *worker, WorkerStrand *strand, BOOL at_top);
+WorkerStrand *worker_pool_take(WorkerPool *pool, Worker *self);
+void worker_pool_run_strand(Worker *self, WorkerStrand *strand);
+void *worker_pool_thread(void *arg);
+void worker_pool_stop(WorkerPool *pool, int n_started);
+
+Status worker_pool_deque_reserve(WorkerDeque *deque, int capacity)
+{
+  WorkerStrand **items = NULL;
+  int new_capacity, i;
+
+  if (deque->capacity >= capacity)
+  {
+    return OK;
+  }
+
+  new_capacity = deque->capacity;
+  while (new_capacity < capacity)
+  {
+    new_capacity *= 2;
+  }
+
+  items = (WorkerStrand **)malloc(new_capacity * sizeof(WorkerStrand *));
+  if (!items)
+  {
+    return ERROR;
+  }
+
+  /* Copia en orden desde el extremo superior para deshacer la vuelta */
+  for (i = 0; i < deque->n_items; i++)
+  {
+    items[i] = deque->items[(deque->top + i) % deque->capacity];
+  }
+  free(deque->items);
+  deque->items = items;
+  deque->capacity = new_capacity;
+  deque->top = 0;
+
+  return OK;
+}
+
+void worker_pool_deque_push(WorkerDeque *deque, WorkerStrand *strand, BOOL at_top)
+{
+  /* Nunca se llena: la capacidad se reserva al crear cada sesion */
+  if (at_top == TRUE)
+  {
+    deque->top = (deque->top + deque->capacity - 1) % deque->capacity;
+    deque->items[deque->top] = strand;
+  }
+  else
+  {
+    deque->items[(deque->top + deque->n_items) % deque->capacity] = strand;
+  }
+  deque->n_items++;
+}
+
+WorkerStrand *worker_pool_deque_pop(WorkerDeque *deque, BOOL from_top)
+{
+  WorkerStrand *strand = NULL;
+
+  if (deque->n_items == 0)
+  {
+    return NULL;
+  }
+
+  deque->n_items--;
+  if (from_top == TRUE)
+  {
+    strand = deque->items[deque->top];
+    deque->top = (deque->top + 1) % deque->capacity;
+  }
+  else
+  {
+    strand = deque->items[(deque->top + deque->n_items) % deque->capacity];
+  }
+  return strand;
+}
+
+void worker_pool_schedule(WorkerPool *pool, Worker *worker, WorkerStrand *strand, BOOL at_top)
+{
+  /* Los envios desde fuera del conjunto se reparten en circulo */
+  if (!worker)
+  {
+    pthread_mutex_lock(&pool->lock);
+    worker = &pool->workers[pool->next_worker];
+    pool->next_worker = (pool->next_worker + 1) % pool->n_workers;
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  pthread_mutex_lock(&worker->deque.lock);
+  worker_pool_deque_push(&worker->deque, strand, at_top);
+  pthread_mutex_unlock(&worker->deque.lock);
+
+  pthread_mutex_lock(&pool->lock);
+  pool->n_ready++;
+  pthread_cond_signal(&pool->ready);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+WorkerStrand *worker_pool_take(WorkerPool *pool, Worker *self)
+{
+  WorkerStrand *strand = NULL;
+  Worker *victim = NULL;
+  int i;
+
+  /* Primero el extremo inferior de la cola propia (lo ultimo que se encolo) */
+  pthread_mutex_lock(&self->deque.lock);
+  strand = worker_pool_deque_pop(&self->deque, FALSE);
+  pthread_mutex_unlock(&self->deque.lock);
+
+  /* Si no hay, se roba el extremo superior de los demas (lo mas antiguo) */
+  for (i = 1; !strand && i < pool->n_workers; i++)
+  {
+    victim = &pool->workers[((self - pool->workers) + i) % pool->n_workers];
+    pthread_mutex_lock(&victim->deque.lock);
+    strand = worker_pool_deque_pop(&victim->deque, TRUE);
+    pthread_mutex_unlock(&victim->deque.lock);
+  }
+
+  if (strand)
+  {
+    pthread_mutex_lock(&pool->lock);
+    pool->n_ready--;
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return strand;
+}
+
+void worker_pool_run_strand(Worker *self, WorkerStrand *strand)
+{
+  WorkerTask *task = NULL;
+  int i;
+
+  for (i = 0; i <= STRAND_BATCH; i++)
+  {
+    pthread_mutex_lock(&strand->lock);
+    task = strand->head;
+    if (!task)
+    {
+      /* Sin tareas: la sesion sale del reparto hasta el proximo envio */
+      strand->scheduled = FALSE;
+      pthread_cond_broadcast(&strand->idle);
+      pthread_mutex_unlock(&strand->lock);
+      return;
+    }
+    if (i == STRAND_BATCH)
+    {
+      pthread_mutex_unlock(&strand->lock);
+      break;
+    }
+    strand->head = task->next;
+    if (!strand->head)
+    {
+      strand->tail = NULL;
+    }
+    pthread_mutex_unlock(&strand->lock);
+
+    task->run(task->arg);
+    free(task);
+  }
+
+  /* Quedan tareas: vuelve por arriba para no acaparar el hilo y poder ser robada */
+  worker_pool_schedule(self->pool, self, strand, TRUE);
+}
+
+void *worker_pool_thread(void *arg)
+{
+  Worker *self = (Worker *)arg;
+  WorkerPool *pool = self->pool;
+  WorkerStrand *strand = NULL;
+
+  pthread_setspecific(pool->current, self);
+
+  while (1)
+  {
+    strand = worker_pool_take(pool, self);
+    if (strand)
+    {
+      worker_pool_run_strand(self, strand);
+      continue;
+    }
+
+    /* Nada que hacer: duerme hasta que se encole una sesion o se cierre */
+    pthread_mutex_lock(&pool->lock);
+    while (pool->n_ready == 0 && !pool->shutdown)
+    {
+      pthread_cond_wait(&pool->ready, &pool->lock);
+    }
+    if (pool->n_ready == 0 && pool->shutdown)
+    {
+      pthread_mutex_unlock(&pool->lock);
+      break;
+    }
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  return NULL;
+}
+
+void worker_pool_stop(WorkerPool *pool, int n_started)
+{
+  int i;
+
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = TRUE;
+  pthread_cond_broadcast(&pool->ready);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (i = 0; i < n_started; i++)
+  {
+    pthread_join(pool->workers[i].thread, NULL);
+  }
+
+  for (i = 0; i < pool->n_workers; i++)
+  {
+    pthread_mutex_destroy(&pool->workers[i].deque.lock);
+    free(pool->workers[i].deque.items);
+  }
+  free(pool->workers);
+  pthread_key_delete(pool->current);
+  pthread_cond_destroy(&pool->ready);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool);
+}
+
+WorkerPool *worker_pool_create(int n_workers)
+{
+  WorkerPool *pool = NULL;
+  int i;
+
+  if (n_workers <= 0)
+  {
+    return NULL;
+  }
+
+  pool = (WorkerPool *)calloc(1, sizeof(WorkerPool));
+  /* Comprueba si falla la reserva de memoria */
+  if (pool == NULL)
+  {
+    return NULL;
+  }
+
+  pool->workers = (Worker *)calloc(n_workers, sizeof(Worker));
+  if (!pool->workers || pthread_key_create(&pool->current, NULL) != 0)
+  {
+    free(pool->workers);
+    free(pool);
+    return NULL;
+  }
+  pool->n_workers = n_workers;
+  pool->shutdown = FALSE;
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->ready, NULL);
+
+  for (i = 0; i < n_workers; i++)
+  {
+    pool->workers[i].pool = pool;
+    pool->workers[i].deque.capacity = INIT_DEQUE;
+    pool->workers[i].deque.items = (WorkerStrand **)malloc(INIT_DEQUE * sizeof(WorkerStrand *));
+    pthread_mutex_init(&pool->workers[i].deque.lock, NULL);
+  }
+  for (i = 0; i < n_workers; i++)
+  {
+    if (!pool->workers[i].deque.items)
+    {
+      worker_pool_stop(pool, 0);
+      return NULL;
+    }
+  }
+
+  /* Arranque de los hilos; si alguno falla se detienen los ya creados */
+  for (i = 0; i < n_workers; i++)
+  {
+    if (pthread_create(&pool->workers[i].thread, NULL, worker_pool_thread, &pool->workers[i]) != 0)
+    {
+      worker_pool_stop(pool, i);
+      return NULL;
+    }
+  }
+
+  return pool;
+}
+
+Status worker_pool_destroy(WorkerPool *pool)
+{
+  if (!pool)
+  {
+    return ERROR;
+  }
+
+  worker_pool_stop(pool, pool->n_workers);
+  return OK;
+}
+
+WorkerStrand *worker_pool_strand_create(WorkerPool *pool)
+{
+  WorkerStrand *strand = NULL;
+  Status status = OK;
+  int n_strands, i;
+
+  if (!pool)
+  {
+    return NULL;
+  }
+
+  strand = (WorkerStrand *)calloc(1, sizeof(WorkerStrand));
+  /* Comprueba si falla la reserva de memoria */
+  if (strand == NULL)
+  {
+    return NULL;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  n_strands = ++pool->n_strands;
+  pthread_mutex_unlock(&pool->lock);
+
+  /* Cada cola debe poder guardar todas las sesiones para no fallar al encolar */
+  for (i = 0; i < pool->n_workers && status == OK; i++)
+  {
+    pthread_mutex_lock(&pool->workers[i].deque.lock);
+    status = worker_pool_deque_reserve(&pool->workers[i].deque, n_strands);
+    pthread_mutex_unlock(&pool->workers[i].deque.lock);
+  }
+  if (status == ERROR)
+  {
+    pthread_mutex_lock(&pool->lock);
+    pool->n_strands--;
+    pthread_mutex_unlock(&pool->lock);
+    free(strand);
+    return NULL;
+  }
+
+  strand->pool = pool;
+  strand->scheduled = FALSE;
+  pthread_mutex_init(&strand->lock, NULL);
+  pthread_cond_init(&strand->idle, NULL);
+
+  return strand;
+}
+
+Status worker_pool_strand_destroy(WorkerStrand *strand)
+{
+  WorkerPool *pool = NULL;
+
+  if (!strand)
+  {
+    return ERROR;
+  }
+
+  /* Espera a que un hilo termine con ella y la saque del reparto */
+  pthread_mutex_lock(&strand->lock);
+  while (strand->scheduled == TRUE)
+  {
+    pthread_cond_wait(&strand->idle, &strand->lock);
+  }
+  pthread_mutex_unlock(&strand->lock);
+
+  pool = strand->pool;
+  pthread_mutex_lock(&pool->lock);
+  pool->n_strands--;
+  pthread_mutex_unlock(&pool->lock);
+
+  pthread_cond_destroy(&strand->idle);
+  pthread_mutex_destroy(&strand->lock);
+  free(strand);
+  return OK;
+}
+
+Status worker_pool_submit(WorkerStrand *strand, WorkerTaskFn run, void *arg)
+{
+  WorkerTask *task = NULL;
+  BOOL schedule = FALSE;
+
+  if (!strand || !run)
+  {
+    return ERROR;
+  }
+
+  task = (WorkerTask *)malloc(sizeof(WorkerTask));
+  /* Comprueba si falla la reserva de memoria */
+  if (task == NULL)
+  {
+    return ERROR;
+  }
+  task->run = run;
+  task->arg = arg;
+  task->next = NULL;
+
+  pthread_mutex_lock(&strand->lock);
+  if (strand->tail)
+  {
+    strand->tail->next = task;
+  }
+  else
+  {
+    strand->head = task;
+  }
+  strand->tail = task;
+
+  /* Solo se encola la sesion si no estaba ya en el reparto */
+  if (strand->scheduled == FALSE)
+  {
+    strand->scheduled = TRUE;
+    schedule = TRUE;
+  }
+  pthread_mutex_unlock(&strand->lock);
+
+  if (schedule == TRUE)
+  {
+    /* Desde un hilo del conjunto se encola en su propia cola */
+    worker_pool_schedule(strand->pool, (Worker *)pthread_getspecific(strand->pool->current), strand, FALSE);
+  }
+
+  return OK;
+}
+
+int worker_pool_get_n_workers(WorkerPool *pool)
+{
+  if (!pool)
+  {
+    return -1;
+  }
+  return pool->n_workers;
+}
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "worker_pool.h"
+#include "worker_pool_test.h"
+#include "test.h"
+#define MAX_TESTS 13
+#define N_TASKS 1000
+#define N_STRANDS 32
+
+/* Registro de una sesion de prueba: solo la escriben sus propias tareas */
+typedef struct
+{
+  int order[N_TASKS];
+  int n_done;
+} TestLog;
+
+typedef struct
+{
+  TestLog *log;
+  int value;
+} TestTask;
+
+void test_worker_pool_record(void *arg);
+
+void test_worker_pool_record(void *arg)
+{
+  TestTask *task = (TestTask *)arg;
+
+  task->log->order[task->log->n_done] = task->value;
+  task->log->n_done++;
+}
+
+int main(int argc, char** argv) {
+    int test = 0;
+    if (argc > 1) test = atoi(argv[1]);
+    if (test < 0 || test > MAX_TESTS) {
+        printf("Error: unknown test %d\t", test);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (test == 0 || test == 1) test1_worker_pool_create();
+    if (test == 0 || test == 2) test2_worker_pool_create();
+    if (test == 0 || test == 3) test1_worker_pool_destroy();
+    if (test == 0 || test == 4) test2_worker_pool_destroy();
+    if (test == 0 || test == 5) test1_worker_pool_strand_create();
+    if (test == 0 || test == 6) test2_worker_pool_strand_create();
+    if (test == 0 || test == 7) test1_worker_pool_strand_destroy();
+    if (test == 0 || test == 8) test2_worker_pool_strand_destroy();
+    if (test == 0 || test == 9) test1_worker_pool_submit();
+    if (test == 0 || test == 10) test2_worker_pool_submit();
+    if (test == 0 || test == 11) test3_worker_pool_submit();
+    if (test == 0 || test == 12) test1_worker_pool_get_n_workers();
+    if (test == 0 || test == 13) test2_worker_pool_get_n_workers();
+
+    PRINT_PASSED_PERCENTAGE;
+    return 0;
+}
+
+void test1_worker_pool_create() {
+    WorkerPool *p = worker_pool_create(4);
+    PRINT_TEST_RESULT(p != NULL);
+    worker_pool_destroy(p);
+}
+
+void test2_worker_pool_create() {
+    PRINT_TEST_RESULT(worker_pool_create(0) == NULL);
+}
+
+void test1_worker_pool_destroy() {
+    WorkerPool *p = worker_pool_create(2);
+    PRINT_TEST_RESULT(worker_pool_destroy(p) == OK);
+}
+
+void test2_worker_pool_destroy() {
+    PRINT_TEST_RESULT(worker_pool_destroy(NULL) == ERROR);
+}
+
+void test1_worker_pool_strand_create() {
+    WorkerPool *p = worker_pool_create(2);
+    WorkerStrand *s = worker_pool_strand_create(p);
+    PRINT_TEST_RESULT(s != NULL);
+    worker_pool_strand_destroy(s);
+    worker_pool_destroy(p);
+}
+
+void test2_worker_pool_strand_create() {
+    PRINT_TEST_RESULT(worker_pool_strand_create(NULL) == NULL);
+}
+
+void test1_worker_pool_strand_destroy() {
+    WorkerPool *p = worker_pool_create(2);
+    WorkerStrand *s = worker_pool_strand_create(p);
+    PRINT_TEST_RESULT(worker_pool_strand_destroy(s) == OK);
+    worker_pool_destroy(p);
+}
+
+void test2_worker_pool_strand_destroy() {
+    PRINT_TEST_RESULT(worker_pool_strand_destroy(NULL) == ERROR);
+}
+
+void test1_worker_pool_submit() {
+    WorkerPool *p = worker_pool_create(4);
+    WorkerStrand *s = worker_pool_strand_create(p);
+    TestLog *log = (TestLog *)calloc(1, sizeof(TestLog));
+    TestTask *tasks = (TestTask *)calloc(N_TASKS, sizeof(TestTask));
+    int i, in_order = 1;
+
+    for (i = 0; i < N_TASKS; i++) {
+        tasks[i].log = log;
+        tasks[i].value = i;
+        worker_pool_submit(s, test_worker_pool_record, &tasks[i]);
+    }
+    /* Destruir la sesion espera a que terminen sus tareas */
+    worker_pool_strand_destroy(s);
+    for (i = 0; i < N_TASKS; i++) {
+        if (log->order[i] != i) in_order = 0;
+    }
+    PRINT_TEST_RESULT(log->n_done == N_TASKS && in_order);
+    worker_pool_destroy(p);
+    free(tasks);
+    free(log);
+}
+
+void test2_worker_pool_submit() {
+    WorkerPool *p = worker_pool_create(4);
+    WorkerStrand *s[N_STRANDS];
+    TestLog *logs = (TestLog *)calloc(N_STRANDS, sizeof(TestLog));
+    TestTask *tasks = (TestTask *)calloc(N_STRANDS * N_TASKS, sizeof(TestTask));
+    int i, j, in_order = 1;
+
+    for (j = 0; j < N_STRANDS; j++) s[j] = worker_pool_strand_create(p);
+    /* Envios intercalados: cada sesion debe conservar su propio orden */
+    for (i = 0; i < N_TASKS; i++) {
+        for (j = 0; j < N_STRANDS; j++) {
+            tasks[j * N_TASKS + i].log = &logs[j];
+            tasks[j * N_TASKS + i].value = i;
+            worker_pool_submit(s[j], test_worker_pool_record, &tasks[j * N_TASKS + i]);
+        }
+    }
+    for (j = 0; j < N_STRANDS; j++) {
+        worker_pool_strand_destroy(s[j]);
+        if (logs[j].n_done != N_TASKS) in_order = 0;
+        for (i = 0; i < logs[j].n_done; i++) {
+            if (logs[j].order[i] != i) in_order = 0;
+        }
+    }
+    PRINT_TEST_RESULT(in_order);
+    worker_pool_destroy(p);
+    free(tasks);
+    free(logs);
+}
+
+void test3_worker_pool_submit() {
+    WorkerPool *p = worker_pool_create(1);
+    WorkerStrand *s = worker_pool_strand_create(p);
+    PRINT_TEST_RESULT(worker_pool_submit(NULL, test_worker_pool_record, NULL) == ERROR && worker_pool_submit(s, NULL, NULL) == ERROR);
+    worker_pool_strand_destroy(s);
+    worker_pool_destroy(p);
+}
+
+void test1_worker_pool_get_n_workers() {
+    WorkerPool *p = worker_pool_create(3);
+    PRINT_TEST_RESULT(worker_pool_get_n_workers(p) == 3);
+    worker_pool_destroy(p);
+}
+
+void test2_worker_pool_get_n_workers() {
+    PRINT_TEST_RESULT(worker_pool_get_n_workers(NULL) == -1);
+}
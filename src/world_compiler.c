@@ -0,0 +1,44 @@
+/**
+ * @brief Compila un mundo de texto a imagen binaria
+ *
+ * @file world_compiler.c
+ * @author Unai
+ * @version 1.0
+ * @date 17-10-2026
+ * @copyright GNU Public License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "game.h"
+#include "game_managment.h"
+
+int main(int argc, char *argv[])
+{
+  Game *game = NULL;
+
+  /* Comprueba los argumentos de entrada */
+  if (argc < 3)
+  {
+    fprintf(stderr, "Uso: %s <world_data_file> <world_image_file>\n", argv[0]);
+    return 1;
+  }
+
+  /* Carga del mundo de texto */
+  if (game_create_from_file(&game, argv[1]) == ERROR)
+  {
+    fprintf(stderr, "Error while loading world %s.\n", argv[1]);
+    return 1;
+  }
+
+  /* Escritura de la imagen compilada */
+  if (game_managment_compile_world(game, argv[2]) == ERROR)
+  {
+    fprintf(stderr, "Error while compiling world image %s.\n", argv[2]);
+    game_destroy(game);
+    return 1;
+  }
+
+  game_destroy(game);
+  return 0;
+}